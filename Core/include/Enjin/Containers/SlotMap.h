@@ -0,0 +1,219 @@
+#pragma once
+
+#include "Enjin/Core/Assert.h"
+#include "Enjin/Memory/MemoryResource.h"
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file SlotMap.h
+ * @brief Generational slot map: stable handles over densely packed values
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+
+/**
+ * @brief Index + generation packed into one integer
+ *
+ * The low IndexBits address a slot, the remaining bits hold the slot's
+ * generation when the handle was issued. Generations start at 1, so a
+ * zero-initialized handle is always invalid.
+ */
+template<typename UInt, u32 IndexBits>
+struct GenerationalHandle {
+    static_assert(std::is_unsigned_v<UInt>, "Handle storage must be an unsigned integer");
+    static_assert(IndexBits > 0 && IndexBits < sizeof(UInt) * 8, "Handle needs both index and generation bits");
+
+    using ValueType = UInt;
+    static constexpr u32  INDEX_BITS = IndexBits;
+    static constexpr u32  GENERATION_BITS = sizeof(UInt) * 8 - IndexBits;
+    static constexpr UInt INDEX_MASK = (UInt(1) << IndexBits) - 1;
+    static constexpr UInt GENERATION_MASK = UInt(~UInt(0)) >> IndexBits;
+    static constexpr UInt MAX_INDEX = INDEX_MASK;
+
+    UInt value = 0;
+
+    static constexpr GenerationalHandle Make(UInt index, UInt generation) {
+        return { static_cast<UInt>((generation << IndexBits) | (index & INDEX_MASK)) };
+    }
+
+    constexpr UInt GetIndex() const { return value & INDEX_MASK; }
+    constexpr UInt GetGeneration() const { return value >> IndexBits; }
+    constexpr bool IsValid() const { return GetGeneration() != 0; }
+
+    constexpr bool operator==(const GenerationalHandle&) const = default;
+};
+
+using SlotHandle32 = GenerationalHandle<u32, 20>; // 1M slots, 4095 generations per slot
+using SlotHandle64 = GenerationalHandle<u64, 32>; // 4G slots, 4G generations per slot
+
+/**
+ * @brief Container with O(1) insert, erase and handle lookup and contiguous values
+ *
+ * Values are packed in one array (erase moves the last value into the hole),
+ * so iteration is a linear walk with no gaps. Handles go through a slot table
+ * that records each value's dense index and the slot's generation; erasing
+ * bumps the generation, so handles to erased values fail lookup instead of
+ * aliasing whatever reuses the slot. Generations wrap after GENERATION_MASK
+ * reuses of one slot (skipping 0), at which point a very old handle could
+ * alias again - use SlotHandle64 where that matters.
+ *
+ * Pointers and references to values are invalidated by Insert and Erase;
+ * hold handles instead. All storage allocates from the given memory resource.
+ *
+ * @threadsafe No
+ *
+ * @example
+ * SlotMap<Mesh> meshes;
+ * SlotHandle32 handle = meshes.Insert(LoadMesh("rock.obj"));
+ * if (Mesh* mesh = meshes.Get(handle)) { Draw(*mesh); }
+ * meshes.Erase(handle);
+ * meshes.Get(handle); // nullptr: the handle is stale
+ */
+template<typename T, typename Handle = SlotHandle32>
+class SlotMap {
+public:
+    using HandleType = Handle;
+    using IndexType = typename Handle::ValueType;
+    using Iterator = typename pmr::Vector<T>::iterator;
+    using ConstIterator = typename pmr::Vector<T>::const_iterator;
+
+    explicit SlotMap(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : m_Slots(resource), m_Values(resource), m_DenseToSlot(resource) {}
+
+    // An invalid handle, with nothing inserted, once all MAX_INDEX + 1 slots are live
+    template<typename... Args>
+    Handle Emplace(Args&&... args) {
+        const IndexType slotIndex = AcquireSlot();
+        if (slotIndex == NONE) {
+            return Handle{};
+        }
+        m_Values.emplace_back(std::forward<Args>(args)...);
+        Slot& slot = m_Slots[slotIndex];
+        slot.dense = static_cast<IndexType>(m_Values.size() - 1);
+        m_DenseToSlot.push_back(slotIndex);
+        return Handle::Make(slotIndex, slot.generation);
+    }
+
+    Handle Insert(const T& value) { return Emplace(value); }
+    Handle Insert(T&& value) { return Emplace(std::move(value)); }
+
+    /**
+     * @brief Remove the value; returns false if the handle was already stale
+     */
+    bool Erase(Handle handle) {
+        if (!Contains(handle)) {
+            return false;
+        }
+        const IndexType slotIndex = handle.GetIndex();
+        Slot& slot = m_Slots[slotIndex];
+        const IndexType dense = slot.dense;
+        const IndexType last = static_cast<IndexType>(m_Values.size() - 1);
+
+        if (dense != last) {
+            m_Values[dense] = std::move(m_Values[last]);
+            m_DenseToSlot[dense] = m_DenseToSlot[last];
+            m_Slots[m_DenseToSlot[dense]].dense = dense;
+        }
+        m_Values.pop_back();
+        m_DenseToSlot.pop_back();
+
+        ReleaseSlot(slotIndex);
+        return true;
+    }
+
+    bool Contains(Handle handle) const {
+        const IndexType index = handle.GetIndex();
+        return index < m_Slots.size() && m_Slots[index].generation == handle.GetGeneration() && handle.IsValid();
+    }
+
+    // nullptr if the handle is stale
+    T* Get(Handle handle) { return Contains(handle) ? &m_Values[m_Slots[handle.GetIndex()].dense] : nullptr; }
+    const T* Get(Handle handle) const { return Contains(handle) ? &m_Values[m_Slots[handle.GetIndex()].dense] : nullptr; }
+
+    // Unchecked in release builds
+    T& operator[](Handle handle) {
+        ENJIN_ASSERT(Contains(handle), "Stale SlotMap handle");
+        return m_Values[m_Slots[handle.GetIndex()].dense];
+    }
+    const T& operator[](Handle handle) const {
+        ENJIN_ASSERT(Contains(handle), "Stale SlotMap handle");
+        return m_Values[m_Slots[handle.GetIndex()].dense];
+    }
+
+    // Handle of the value at a dense position, for iterating with handles
+    Handle GetHandleAt(usize denseIndex) const {
+        const IndexType slotIndex = m_DenseToSlot[denseIndex];
+        return Handle::Make(slotIndex, m_Slots[slotIndex].generation);
+    }
+
+    /**
+     * @brief Erase everything; outstanding handles all become stale
+     */
+    void Clear() {
+        for (IndexType slotIndex : m_DenseToSlot) {
+            ReleaseSlot(slotIndex);
+        }
+        m_Values.clear();
+        m_DenseToSlot.clear();
+    }
+
+    void Reserve(usize capacity) {
+        m_Slots.reserve(capacity);
+        m_Values.reserve(capacity);
+        m_DenseToSlot.reserve(capacity);
+    }
+
+    usize Size() const { return m_Values.size(); }
+    bool Empty() const { return m_Values.empty(); }
+
+    T* Data() { return m_Values.data(); }
+    const T* Data() const { return m_Values.data(); }
+
+    Iterator begin() { return m_Values.begin(); }
+    Iterator end() { return m_Values.end(); }
+    ConstIterator begin() const { return m_Values.begin(); }
+    ConstIterator end() const { return m_Values.end(); }
+
+private:
+    static constexpr IndexType NONE = std::numeric_limits<IndexType>::max();
+
+    struct Slot {
+        IndexType dense;      // Position in m_Values while live, next free slot while free
+        IndexType generation; // Current generation; handles must match it
+    };
+
+    // NONE when the handle index space is exhausted
+    IndexType AcquireSlot() {
+        if (m_FreeHead != NONE) {
+            const IndexType slotIndex = m_FreeHead;
+            m_FreeHead = m_Slots[slotIndex].dense;
+            return slotIndex;
+        }
+        if (m_Slots.size() > Handle::MAX_INDEX) {
+            return NONE;
+        }
+        m_Slots.push_back({ NONE, 1 });
+        return static_cast<IndexType>(m_Slots.size() - 1);
+    }
+
+    void ReleaseSlot(IndexType slotIndex) {
+        Slot& slot = m_Slots[slotIndex];
+        slot.generation = (slot.generation + 1) & Handle::GENERATION_MASK;
+        if (slot.generation == 0) {
+            slot.generation = 1;
+        }
+        slot.dense = m_FreeHead;
+        m_FreeHead = slotIndex;
+    }
+
+    pmr::Vector<Slot> m_Slots;
+    pmr::Vector<T> m_Values;
+    pmr::Vector<IndexType> m_DenseToSlot;
+    IndexType m_FreeHead = NONE;
+};
+
+} // namespace Enjin
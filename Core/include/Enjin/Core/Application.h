@@ -14,6 +14,7 @@ namespace Enjin {
 
 // Forward declarations
 class Window;
+class FrameAllocator;
 
 /**
  * @brief Application base class
@@ -55,6 +56,18 @@ public:
      */
     virtual void Render() {}
 
+    /**
+     * @brief Per-frame scratch memory, reset automatically at the top of each frame
+     *
+     * Allocations stay valid until MAX_FRAMES_IN_FLIGHT more frames have
+     * begun. That is CPU-side lifetime only: it is not tied to the renderer's
+     * fences, so GPU work must not read frame memory. Also reachable from
+     * code without an Application pointer via Enjin::GetFrameAllocator().
+     *
+     * @threadsafe Yes (each thread bump-allocates from its own chunk)
+     */
+    FrameAllocator& GetFrameAllocator() const { return *m_FrameAllocator; }
+
 protected:
     /**
      * @brief Get the application window
@@ -68,6 +81,7 @@ private:
     void MainLoop();
 
     Window* m_Window = nullptr;
+    FrameAllocator* m_FrameAllocator = nullptr;
     bool m_Running = true;
     f32 m_LastFrameTime = 0.0f;
 };
@@ -2,6 +2,7 @@
 
 #include "Enjin/Platform/Platform.h"
 #include "Enjin/Platform/Types.h"
+#include <cstdarg>
 #include <string>
 #include <string_view>
 #include <mutex>
@@ -57,9 +58,12 @@ private:
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
-    std::string GetLogLevelString(LogLevel level) const;
-    std::string GetCategoryString(LogCategory category) const;
-    std::string GetTimestamp() const;
+    // Formats the entry into a stack buffer and writes it; no heap traffic per message
+    void Write(LogLevel level, LogCategory category, const char* file, u32 line, const char* function, const char* format, va_list args);
+
+    const char* GetLogLevelString(LogLevel level) const;
+    const char* GetCategoryString(LogCategory category) const;
+    void GetTimestamp(char* buffer, usize size) const;
 
     LogLevel m_MinLogLevel = LogLevel::Trace;
     bool m_CategoryEnabled[static_cast<usize>(LogCategory::Count)] = { true };
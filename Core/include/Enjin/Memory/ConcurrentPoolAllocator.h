@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Enjin/Memory/Memory.h"
+#include <atomic>
+#include <mutex>
+
+/**
+ * @file ConcurrentPoolAllocator.h
+ * @brief Fixed-size object pool that can be allocated from and freed to on any thread
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+
+struct ConcurrentPoolDesc {
+    usize objectSize = 0;
+    usize alignment = DEFAULT_ALIGNMENT;
+    u32   maxObjects = 1u << 24;   // Address space reserved up front (committed on demand)
+    u32   batchSize = 64;          // Objects moved between a thread cache and the global list at once
+};
+
+/**
+ * @brief Thread-safe fixed-size pool for objects that cross threads
+ *
+ * Each thread allocates from and frees into its own cache, so an object
+ * allocated on the main thread and freed on a worker simply lands in the
+ * worker's cache. Caches exchange whole batches with a global lock-free
+ * Treiber stack; its head packs a 32-bit object index with a 32-bit tag, so a
+ * plain 64-bit CAS is ABA-safe. Objects live in one reserved virtual range
+ * that is committed as the pool grows and never moves, which also makes
+ * reading a stale batch link during a lost CAS race harmless.
+ *
+ * Threads beyond MAX_THREAD_CACHES share the global stack directly.
+ *
+ * @performance Allocate/Deallocate: no atomics on the hot path, one CAS per batch
+ * @threadsafe Yes
+ */
+class ENJIN_API ConcurrentPoolAllocator : public IAllocator {
+public:
+    static constexpr u32 MAX_THREAD_CACHES = 256;
+
+    explicit ConcurrentPoolAllocator(const ConcurrentPoolDesc& desc);
+    ConcurrentPoolAllocator(usize objectSize, u32 maxObjects);
+    ~ConcurrentPoolAllocator() override;
+
+    ConcurrentPoolAllocator(const ConcurrentPoolAllocator&) = delete;
+    ConcurrentPoolAllocator& operator=(const ConcurrentPoolAllocator&) = delete;
+
+    void* Allocate(usize size, usize alignment = DEFAULT_ALIGNMENT) override;
+    void  Deallocate(void* ptr) override;
+    usize GetTotalAllocated() const override;
+    usize GetTotalCapacity() const override;
+    usize GetAllocationSize(const void* ptr) const override;
+
+    /**
+     * @brief Push the calling thread's cached objects to the global stack
+     */
+    void FlushThreadCache();
+
+    usize GetObjectStride() const { return m_Stride; }
+
+private:
+    // A free object; the head of a batch also links to the next batch
+    struct FreeBlock {
+        FreeBlock* next;    // Next object in the same batch
+        u32 nextBatch;      // Index + 1 of the next batch head, 0 = none
+        u32 count;          // Objects in this batch
+    };
+
+    struct alignas(CACHE_LINE_SIZE) ThreadCache {
+        FreeBlock* head = nullptr;
+        u32 count = 0;
+        std::atomic<i64> liveObjects{0}; // Single writer: the thread owning this slot
+    };
+
+    static u64 Pack(u32 index, u32 tag) { return (static_cast<u64>(tag) << 32) | index; }
+
+    u32 IndexOf(const void* ptr) const;
+    FreeBlock* BlockAt(u32 index) const;
+
+    ThreadCache* GetThreadCache();
+    FreeBlock* PopBatch(u32& outCount);
+    void PushBatch(FreeBlock* head, u32 count);
+    FreeBlock* CarveBatch(u32& outCount);
+
+    u8* m_Memory = nullptr;
+    usize m_ObjectSize;
+    usize m_Alignment;
+    usize m_Stride;
+    u32 m_MaxObjects;
+    u32 m_BatchSize;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<u64> m_GlobalHead{0}; // (tag << 32) | (index + 1)
+    alignas(CACHE_LINE_SIZE) std::atomic<i64> m_SharedLiveObjects{0}; // Threads without a cache
+
+    std::mutex m_GrowMutex;
+    std::atomic<u32> m_Carved{0}; // Objects handed out from fresh memory; written under m_GrowMutex
+    usize m_Committed = 0;
+    usize m_Reserved = 0;
+
+    ThreadCache m_Caches[MAX_THREAD_CACHES];
+};
+
+} // namespace Enjin
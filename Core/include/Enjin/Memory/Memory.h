@@ -17,7 +17,8 @@ constexpr usize CACHE_LINE_SIZE = 64;
 // Memory allocation functions
 ENJIN_API void* Allocate(usize size, usize alignment = DEFAULT_ALIGNMENT);
 ENJIN_API void  Deallocate(void* ptr);
-ENJIN_API void* Reallocate(void* ptr, usize newSize, usize alignment = DEFAULT_ALIGNMENT);
+ENJIN_API void* Reallocate(void* ptr, usize newSize, usize alignment = DEFAULT_ALIGNMENT); // newSize 0 frees
+ENJIN_API usize GetAllocationSize(const void* ptr); // Usable size, 0 if unknown
 
 // Memory utilities
 ENJIN_API usize GetAlignmentOffset(void* ptr, usize alignment);
@@ -33,71 +34,151 @@ public:
     virtual void  Deallocate(void* ptr) = 0;
     virtual usize GetTotalAllocated() const = 0;
     virtual usize GetTotalCapacity() const = 0;
+
+    // Usable size of a live allocation, or 0 if this allocator does not track it
+    virtual usize GetAllocationSize(const void* ptr) const { (void)ptr; return 0; }
+
+    // Resize an allocation, preserving min(old, new) bytes. Returns nullptr on
+    // failure and leaves the original block untouched. The default implementation
+    // allocates, copies and frees; allocators override it to grow in place.
+    virtual void* Reallocate(void* ptr, usize newSize, usize alignment = DEFAULT_ALIGNMENT);
+};
+
+// Virtual memory arena backing for StackAllocator / LinearAllocator.
+// Reserves reserveSize bytes of address space up front (no physical memory) and
+// commits pages as the offset grows, so pointers never move and a generous
+// reserve costs nothing until it is touched.
+struct VirtualArenaDesc {
+    usize reserveSize = 0;               // Upper bound on the arena, e.g. 1 GB
+    usize commitGranularity = 64 * 1024; // Commit in steps of at least this many bytes
+    bool  decommitOnReset = false;       // Return committed pages to the OS on Reset()
+    usize retainOnReset = 0;             // Bytes kept committed when decommitting
 };
 
 // Stack allocator - Fast, but requires deallocation in reverse order
 class ENJIN_API StackAllocator : public IAllocator {
 public:
     StackAllocator(usize size);
+    explicit StackAllocator(const VirtualArenaDesc& arena);
     ~StackAllocator();
 
     void* Allocate(usize size, usize alignment = DEFAULT_ALIGNMENT) override;
     void  Deallocate(void* ptr) override;
     usize GetTotalAllocated() const override;
     usize GetTotalCapacity() const override;
+    usize GetAllocationSize(const void* ptr) const override; // Top allocation only
+    void* Reallocate(void* ptr, usize newSize, usize alignment = DEFAULT_ALIGNMENT) override;
 
     void Reset(); // Reset to beginning (only if all allocations are freed)
     usize GetMarker() const; // Get current position
     void  FreeToMarker(usize marker); // Free all allocations after marker
+    usize GetCommittedSize() const { return m_Committed; }
 
 private:
+    bool EnsureCommitted(usize end);
+
     u8* m_Memory;
     usize m_Size;
     usize m_Offset;
+    u8* m_LastAllocation = nullptr; // Top of stack, can be resized in place
+    VirtualArenaDesc m_Arena;       // reserveSize == 0 for malloc-backed stacks
+    usize m_Committed = 0;
+};
+
+struct PoolAllocatorDesc {
+    usize objectSize = 0;
+    usize objectsPerSlab = 256;          // Minimum; slabs are rounded up to a power of two in bytes
+    usize alignment = DEFAULT_ALIGNMENT; // Power of two, up to CACHE_LINE_SIZE and beyond
+    usize maxSlabs = 0;                  // 0 = grow without limit
+    bool  releaseEmptySlabs = false;     // Unmap slabs whose objects were all freed (one is always kept)
 };
 
-// Pool allocator - Fast allocation/deallocation for fixed-size objects
+// Pool allocator - Fast allocation/deallocation for fixed-size objects.
+// Grows by whole slabs mapped from the OS; each slab is aligned to its own size
+// so Deallocate finds the owning slab with a mask. Statistics are live counters.
 class ENJIN_API PoolAllocator : public IAllocator {
 public:
-    PoolAllocator(usize objectSize, usize objectCount);
+    PoolAllocator(usize objectSize, usize objectCount); // objectCount objects per slab, growable
+    explicit PoolAllocator(const PoolAllocatorDesc& desc);
     ~PoolAllocator();
 
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
     void* Allocate(usize size, usize alignment = DEFAULT_ALIGNMENT) override;
     void  Deallocate(void* ptr) override;
-    usize GetTotalAllocated() const override;
-    usize GetTotalCapacity() const override;
+    usize GetTotalAllocated() const override; // O(1)
+    usize GetTotalCapacity() const override;  // O(1)
+    usize GetAllocationSize(const void* ptr) const override;
+
+    usize GetLiveCount() const { return m_LiveCount; }
+    usize GetSlabCount() const { return m_SlabCount; }
+    usize GetObjectStride() const { return m_Stride; }
 
 private:
     struct FreeBlock {
         FreeBlock* next;
     };
 
-    u8* m_Memory;
+    struct Slab {
+        Slab* prev;
+        Slab* next;
+        FreeBlock* freeList;
+        u32 liveCount;
+        u32 carved; // Objects handed out at least once; the rest are carved lazily
+    };
+
+    Slab* CreateSlab();
+    void  DestroySlab(Slab* slab);
+    void  LinkSlab(Slab*& list, Slab* slab);
+    void  UnlinkSlab(Slab*& list, Slab* slab);
+    u8*   GetSlabObjects(Slab* slab) const { return reinterpret_cast<u8*>(slab) + m_HeaderSize; }
+
     usize m_ObjectSize;
-    usize m_ObjectCount;
-    FreeBlock* m_FreeList;
+    usize m_Alignment;
+    usize m_Stride;          // Object size rounded up to the alignment
+    usize m_HeaderSize;      // Slab header rounded up to the alignment
+    usize m_SlabBytes;       // Power of two
+    u32   m_ObjectsPerSlab;
+    usize m_MaxSlabs;
+    bool  m_ReleaseEmptySlabs;
+
+    Slab* m_Available = nullptr; // Slabs with at least one free object
+    Slab* m_Full = nullptr;
+    usize m_LiveCount = 0;
+    usize m_SlabCount = 0;
 };
 
 // Linear allocator - Very fast, but can only reset all at once
 class ENJIN_API LinearAllocator : public IAllocator {
 public:
     LinearAllocator(usize size);
+    explicit LinearAllocator(const VirtualArenaDesc& arena);
     ~LinearAllocator();
 
     void* Allocate(usize size, usize alignment = DEFAULT_ALIGNMENT) override;
     void  Deallocate(void* ptr) override;
     usize GetTotalAllocated() const override;
     usize GetTotalCapacity() const override;
+    usize GetAllocationSize(const void* ptr) const override; // Last allocation only
+    void* Reallocate(void* ptr, usize newSize, usize alignment = DEFAULT_ALIGNMENT) override;
 
     void Reset(); // Reset to beginning
+    usize GetCommittedSize() const { return m_Committed; }
 
 private:
+    bool EnsureCommitted(usize end);
+
     u8* m_Memory;
     usize m_Size;
     usize m_Offset;
+    u8* m_LastAllocation = nullptr; // Most recent block, can be resized in place
+    VirtualArenaDesc m_Arena;       // reserveSize == 0 for malloc-backed arenas
+    usize m_Committed = 0;
 };
 
-// Global default allocator
+// Global default allocator (ThreadCachingAllocator unless replaced;
+// passing nullptr to SetDefaultAllocator restores the built-in one)
 ENJIN_API IAllocator* GetDefaultAllocator();
 ENJIN_API void        SetDefaultAllocator(IAllocator* allocator);
 
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Enjin/Memory/Memory.h"
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file MemoryResource.h
+ * @brief std::pmr bridge so standard containers can allocate from any IAllocator
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+
+/**
+ * @brief Exposes an IAllocator as a std::pmr::memory_resource
+ *
+ * Lets a World, a RenderGraph or a frame's worth of containers live in one
+ * arena: build them on an AllocatorResource over a LinearAllocator and the
+ * whole lot is released by one Reset(). The resource does not own the
+ * allocator, which must outlive every container using it.
+ *
+ * Allocation failure throws std::bad_alloc, as memory_resource requires.
+ *
+ * @example
+ * LinearAllocator arena(VirtualArenaDesc{ 64ull << 20 });
+ * AllocatorResource resource(arena);
+ * pmr::Vector<Entity> visible(&resource);
+ */
+class ENJIN_API AllocatorResource final : public std::pmr::memory_resource {
+public:
+    explicit AllocatorResource(IAllocator& allocator) : m_Allocator(allocator) {}
+
+    IAllocator& GetAllocator() const { return m_Allocator; }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void  do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+    bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    IAllocator& m_Allocator;
+};
+
+/**
+ * @brief Resource over Enjin::Allocate / Deallocate (the tracked global heap)
+ *
+ * Unlike std::pmr::new_delete_resource(), over-aligned requests stay on the
+ * engine heap instead of falling through to aligned operator new.
+ */
+ENJIN_API std::pmr::memory_resource* GetHeapResource();
+
+// Container aliases for engine code that accepts a memory resource
+namespace pmr {
+
+template<typename T>
+using Vector = std::pmr::vector<T>;
+
+template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using UnorderedMap = std::pmr::unordered_map<Key, Value, Hash, KeyEqual>;
+
+using String = std::pmr::string;
+
+} // namespace pmr
+
+} // namespace Enjin
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "Enjin/Memory/Memory.h"
+
+/**
+ * @file MemoryTracker.h
+ * @brief Per-subsystem memory accounting: live bytes, counts, peaks and budgets
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+
+enum class MemoryTag : u8 {
+    General  = 0, // Untagged allocations
+    Renderer = 1,
+    Physics  = 2,
+    ECS      = 3,
+    Asset    = 4,
+    Audio    = 5,
+    Log      = 6,
+    GUI      = 7,
+    World    = 8, // Terrain, weather, water
+    Script   = 9,
+    Editor   = 10,
+    Count
+};
+
+constexpr usize MEMORY_TAG_COUNT = static_cast<usize>(MemoryTag::Count);
+
+ENJIN_API const char* GetMemoryTagName(MemoryTag tag);
+
+struct MemoryTagStats {
+    i64 liveBytes = 0;
+    i64 liveCount = 0;
+    i64 peakBytes = 0;       // Highest liveBytes seen by MemoryTracker::Update()
+    i64 totalAllocations = 0;
+};
+
+struct MemorySnapshot {
+    MemoryTagStats tags[MEMORY_TAG_COUNT];
+
+    const MemoryTagStats& operator[](MemoryTag tag) const { return tags[static_cast<usize>(tag)]; }
+
+    /**
+     * @brief Per-tag change from before to after; peakBytes is taken from after
+     *
+     * A tag whose liveBytes keeps growing between two equivalent frames is leaking.
+     */
+    static MemorySnapshot Diff(const MemorySnapshot& before, const MemorySnapshot& after);
+};
+
+/**
+ * @brief Process-wide memory accounting by MemoryTag
+ *
+ * Enjin::Allocate (and therefore global operator new) tags every block with
+ * the calling thread's current tag (see MemoryTagScope) and stores it in a
+ * 16-byte header, so frees are charged to the tag that allocated, whichever
+ * thread frees. Other allocators are accounted by wrapping them in a
+ * TrackedAllocator.
+ *
+ * Counters live per thread and have a single writer, so recording costs a few
+ * relaxed stores and no locked instructions; queries sum over all threads.
+ * Peaks and budgets are evaluated by Update(), which Application calls once a
+ * frame, so peaks have frame granularity.
+ *
+ * Global heap tracking is compiled in unless ENJIN_MEMORY_TRACKING is 0.
+ *
+ * @threadsafe Yes
+ *
+ * @example
+ * MemoryTracker::SetBudget(MemoryTag::Physics, 64 * 1024 * 1024);
+ * MemorySnapshot before = MemoryTracker::TakeSnapshot();
+ * RunFrame();
+ * MemoryTracker::LogDiff(before, MemoryTracker::TakeSnapshot());
+ */
+class ENJIN_API MemoryTracker {
+public:
+    static void RecordAllocation(MemoryTag tag, usize bytes);
+    static void RecordDeallocation(MemoryTag tag, usize bytes);
+
+    // Tag applied to allocations made by the calling thread
+    static MemoryTag GetCurrentTag();
+    static void      SetCurrentTag(MemoryTag tag);
+
+    static MemoryTagStats GetStats(MemoryTag tag);
+    static MemorySnapshot TakeSnapshot();
+
+    // Warn once when a tag's live bytes exceed its budget (0 = no budget)
+    static void  SetBudget(MemoryTag tag, usize bytes);
+    static usize GetBudget(MemoryTag tag);
+
+    /**
+     * @brief Fold current totals into peaks and check budgets
+     */
+    static void Update();
+
+    static void LogSnapshot(const MemorySnapshot& snapshot);
+    static void LogDiff(const MemorySnapshot& before, const MemorySnapshot& after);
+};
+
+/**
+ * @brief Tags the calling thread's allocations for the lifetime of the scope
+ *
+ * @example
+ * MemoryTagScope tag(MemoryTag::Renderer);
+ * m_Pipelines.push_back(std::make_unique<Pipeline>()); // Charged to Renderer
+ */
+class MemoryTagScope {
+public:
+    explicit MemoryTagScope(MemoryTag tag) : m_Previous(MemoryTracker::GetCurrentTag()) {
+        MemoryTracker::SetCurrentTag(tag);
+    }
+    ~MemoryTagScope() { MemoryTracker::SetCurrentTag(m_Previous); }
+
+    MemoryTagScope(const MemoryTagScope&) = delete;
+    MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+private:
+    MemoryTag m_Previous;
+};
+
+/**
+ * @brief Charges the blocks allocated through it to one tag
+ *
+ * Each block is charged its inner GetAllocationSize() when allocated and
+ * released when freed, through the calling thread's counters, so the wrapper
+ * holds no shared state and other users of the inner allocator are not
+ * counted. The inner allocator must report the size of every live block
+ * (TLSF, pools, ThreadCachingAllocator); arenas only know their top block,
+ * so tag their backing memory instead. Blocks still live when the wrapper
+ * is destroyed stay charged.
+ */
+class ENJIN_API TrackedAllocator : public IAllocator {
+public:
+    TrackedAllocator(IAllocator& inner, MemoryTag tag);
+
+    void* Allocate(usize size, usize alignment = DEFAULT_ALIGNMENT) override;
+    void  Deallocate(void* ptr) override;
+    usize GetTotalAllocated() const override { return m_Inner.GetTotalAllocated(); }
+    usize GetTotalCapacity() const override { return m_Inner.GetTotalCapacity(); }
+    usize GetAllocationSize(const void* ptr) const override { return m_Inner.GetAllocationSize(ptr); }
+    void* Reallocate(void* ptr, usize newSize, usize alignment = DEFAULT_ALIGNMENT) override;
+
+    IAllocator& GetInner() const { return m_Inner; }
+    MemoryTag GetTag() const { return m_Tag; }
+
+private:
+    IAllocator& m_Inner;
+    MemoryTag m_Tag;
+};
+
+} // namespace Enjin
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "Enjin/Memory/Memory.h"
+#include <atomic>
+#include <mutex>
+
+/**
+ * @file ThreadCachingAllocator.h
+ * @brief General-purpose size-class allocator with per-thread caches
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+
+/**
+ * @brief Built-in general-purpose allocator behind the global operator new
+ *
+ * Small requests (up to MAX_SMALL_SIZE) are rounded to one of ~40 size classes
+ * and served from a thread-local free list without locks or syscalls. When a
+ * thread's list runs dry it pulls a batch of objects from a per-class central
+ * list (the only lock on the small path, amortised over the batch). Central
+ * lists carve objects out of 64 KB-aligned spans mapped directly from the OS.
+ * Large requests are mapped individually and resized with mremap where available.
+ *
+ * A page map from 64 KB page to span makes ownership queries O(1), so pointers
+ * that did not come from this allocator are forwarded to std::free.
+ *
+ * Installed as the default allocator; SetDefaultAllocator(nullptr) restores it.
+ *
+ * @performance Small Allocate/Deallocate: a handful of instructions on the hot path
+ * @threadsafe Yes
+ */
+class ENJIN_API ThreadCachingAllocator final : public IAllocator {
+public:
+    static constexpr usize MAX_SMALL_SIZE = 32 * 1024;
+    static constexpr usize PAGE_SHIFT = 16;
+    static constexpr usize PAGE_SIZE = usize(1) << PAGE_SHIFT; // Span granularity
+    static constexpr u32   NUM_SIZE_CLASSES = 40;
+
+    static ThreadCachingAllocator& Get();
+
+    void* Allocate(usize size, usize alignment = DEFAULT_ALIGNMENT) override;
+    void  Deallocate(void* ptr) override;
+    usize GetTotalAllocated() const override;
+    usize GetTotalCapacity() const override;
+    usize GetAllocationSize(const void* ptr) const override;
+
+    /**
+     * @brief Resize without copying whenever possible
+     *
+     * Small blocks stay put while the new size still fits their size class.
+     * Large blocks are grown or shrunk with VirtualMemory::Remap, which moves
+     * page-table entries instead of bytes. Everything else copies
+     * min(old usable size, newSize) bytes.
+     */
+    void* Reallocate(void* ptr, usize newSize, usize alignment = DEFAULT_ALIGNMENT) override;
+
+    /**
+     * @brief Check whether ptr was handed out by this allocator
+     * @threadsafe Yes (lock-free page map lookup)
+     */
+    bool Owns(const void* ptr) const;
+
+    /**
+     * @brief Return the current thread's cached objects to the central lists
+     */
+    void FlushThreadCache();
+
+    // Size class helpers (exposed for tooling and tests)
+    static u32   GetSizeClass(usize size);
+    static usize GetClassSize(u32 sizeClass);
+
+    ~ThreadCachingAllocator() override = default;
+
+    struct FreeObject {
+        FreeObject* next;
+    };
+
+    struct Span;
+    struct ThreadCache;
+
+private:
+    static constexpr usize ROOT_BITS = 16;
+    static constexpr usize LEAF_BITS = 16;
+    static constexpr usize MAX_TRANSFER_BATCHES = 64;
+    static constexpr u16   LARGE_SPAN = 0xFFFF;
+
+    struct PageMapLeaf {
+        std::atomic<Span*> spans[usize(1) << LEAF_BITS];
+    };
+
+    struct CentralList {
+        std::mutex mutex;
+        FreeObject* batches[MAX_TRANSFER_BATCHES] = {};
+        u32 batchCount = 0;
+        FreeObject* loose = nullptr; // Partial batches and objects freed by exiting threads
+        u32 looseCount = 0;
+        u8* carveCursor = nullptr;
+        u8* carveEnd = nullptr;
+    };
+
+    friend struct ThreadCacheReaper;
+
+    // Constant-initialized so operator new works during static initialization
+    constexpr ThreadCachingAllocator() = default;
+    static ThreadCachingAllocator s_Instance;
+
+    ThreadCache* GetThreadCache();
+    void ReleaseThreadCache(ThreadCache* cache);
+
+    FreeObject* FetchBatch(u32 sizeClass, u32& outCount);
+    void ReleaseToCentral(u32 sizeClass, FreeObject* head, FreeObject* tail, u32 count);
+    void ReleaseObjects(ThreadCache* cache, u32 sizeClass, u32 count);
+
+    void* AllocateLarge(usize size, usize alignment);
+    void  DeallocateLarge(Span* span);
+    void* ResizeLarge(Span* span, usize newSize, usize alignment);
+
+    Span* CreateSpan(usize bytes, usize alignment, u16 sizeClass);
+    void  DestroySpan(Span* span);
+    Span* NewSpanRecord();
+    void  RegisterSpan(Span* span, Span* value);
+    Span* LookupSpan(const void* ptr) const;
+
+    CentralList m_Central[NUM_SIZE_CLASSES];
+
+    std::atomic<PageMapLeaf*> m_PageMap[usize(1) << ROOT_BITS] = {};
+
+    std::mutex m_PageMutex;        // Span creation/destruction and page map leaves
+    Span* m_FreeSpanRecords = nullptr;
+
+    mutable std::mutex m_RegistryMutex; // Live thread caches (for statistics)
+    ThreadCache* m_Caches = nullptr;
+
+    std::atomic<i64> m_RetiredBytes{0};  // Net bytes from exited threads
+    std::atomic<i64> m_LargeBytes{0};
+    std::atomic<usize> m_MappedBytes{0};
+};
+
+} // namespace Enjin
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "Enjin/Memory/Memory.h"
+#include <vector>
+
+/**
+ * @file TlsfAllocator.h
+ * @brief Two-level segregated fit allocation: O(1) allocate and free for variable sizes
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+
+/**
+ * @brief A block handed out by TlsfRange
+ */
+struct TlsfAllocation {
+    static constexpr u32 INVALID = ~0u;
+
+    u64 offset = 0;
+    u32 metadata = INVALID; // Block record inside the range, needed to free
+
+    bool IsValid() const { return metadata != INVALID; }
+};
+
+/**
+ * @brief TLSF bookkeeping for an abstract [0, size) range
+ *
+ * Never touches the managed memory: block records live in a side array sized
+ * for maxAllocations up front, so the range can describe a GPU heap or a
+ * staging buffer as easily as CPU memory. Free blocks sit in FL_COUNT x
+ * SL_COUNT (60 x 32) segregated lists indexed through two bitmaps, so
+ * finding a fit is two bit scans, and neighbouring free blocks are merged
+ * on free.
+ *
+ * Every size is rounded up to the granularity; alignments up to the
+ * granularity are free, larger ones may split a padding block off the front.
+ *
+ * @performance Allocate/Free: O(1), no allocation after construction
+ * @threadsafe No
+ *
+ * @example
+ * TlsfRange heap(256ull << 20, 4096, 256); // 256 MB device heap
+ * TlsfAllocation vb = heap.Allocate(vertexBytes, 256);
+ * vkBindBufferMemory(device, buffer, memory, vb.offset);
+ * heap.Free(vb);
+ */
+class ENJIN_API TlsfRange {
+public:
+    static constexpr u32 SL_BITS = 5;
+    static constexpr u32 SL_COUNT = 1u << SL_BITS;
+    static constexpr u32 FL_COUNT = 64 - SL_BITS + 1;
+    static_assert(FL_COUNT == 60 && SL_COUNT == 32, "Update the list count in the class comment");
+
+    TlsfRange(u64 size, u32 maxAllocations, u64 granularity = DEFAULT_ALIGNMENT);
+
+    /**
+     * @brief Find a free block of at least size bytes at an aligned offset
+     * @return Invalid allocation if no block fits or maxAllocations is reached
+     */
+    TlsfAllocation Allocate(u64 size, u64 alignment = 1);
+    void Free(TlsfAllocation allocation);
+
+    u64 GetAllocationSize(TlsfAllocation allocation) const; // Rounded block size
+    u64 GetSize() const { return m_Size; }
+    u64 GetUsedSize() const { return m_UsedSize; }
+    u32 GetAllocationCount() const { return m_AllocationCount; }
+    u64 GetLargestFreeBlock() const;
+
+private:
+    static constexpr u32 NONE = ~0u;
+
+    struct Block {
+        u64 offset;
+        u64 size;
+        u32 prevPhysical;
+        u32 nextPhysical;
+        u32 prevFree;
+        u32 nextFree;
+        bool used;
+    };
+
+    static void MapInsert(u64 size, u32& fl, u32& sl);
+    static void MapSearch(u64 size, u32& fl, u32& sl);
+
+    u32  FindFreeBlock(u64 size) const;
+    void InsertFree(u32 index);
+    void RemoveFree(u32 index);
+    u32  AcquireBlock();
+    void ReleaseBlock(u32 index);
+    u32  SplitBlock(u32 index, u64 size); // Tail after size becomes a new free block
+
+    u64 m_Size;
+    u64 m_Granularity;
+    u64 m_UsedSize = 0;
+    u32 m_MaxAllocations;
+    u32 m_AllocationCount = 0;
+
+    u64 m_FirstLevelMap = 0;
+    u32 m_SecondLevelMap[FL_COUNT] = {};
+    u32 m_FreeHeads[FL_COUNT][SL_COUNT];
+
+    std::vector<Block> m_Blocks;
+    std::vector<u32> m_UnusedBlocks; // Stack of free record slots
+};
+
+/**
+ * @brief General-purpose IAllocator with bounded latency, built on TlsfRange
+ *
+ * Suits variable-sized data whose lifetime fits neither a stack nor a pool
+ * (mesh data, material blobs). The arena is mapped once; each block carries a
+ * small header holding its TlsfRange record.
+ *
+ * @performance Allocate/Deallocate: O(1) worst case
+ * @threadsafe No
+ */
+class ENJIN_API TlsfAllocator : public IAllocator {
+public:
+    explicit TlsfAllocator(usize size, u32 maxAllocations = 0); // 0 = one per 256 bytes
+    ~TlsfAllocator() override;
+
+    TlsfAllocator(const TlsfAllocator&) = delete;
+    TlsfAllocator& operator=(const TlsfAllocator&) = delete;
+
+    void* Allocate(usize size, usize alignment = DEFAULT_ALIGNMENT) override;
+    void  Deallocate(void* ptr) override;
+    usize GetTotalAllocated() const override;
+    usize GetTotalCapacity() const override;
+    usize GetAllocationSize(const void* ptr) const override;
+
+    const TlsfRange& GetRange() const { return m_Range; }
+
+private:
+    struct Header {
+        u32 metadata;
+        u32 headerSize; // Distance from block start to the user pointer
+    };
+
+    const Header* GetHeader(const void* ptr) const {
+        return reinterpret_cast<const Header*>(static_cast<const u8*>(ptr) - sizeof(Header));
+    }
+
+    u8* m_Memory;
+    usize m_Size;
+    TlsfRange m_Range;
+};
+
+} // namespace Enjin
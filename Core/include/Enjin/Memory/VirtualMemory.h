@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Enjin/Platform/Platform.h"
+#include "Enjin/Platform/Types.h"
+
+/**
+ * @file VirtualMemory.h
+ * @brief Thin wrapper over the OS virtual memory API (mmap / VirtualAlloc)
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+namespace VirtualMemory {
+
+/**
+ * @brief Size of an OS page in bytes (4 KB on most desktop platforms)
+ */
+ENJIN_API usize GetPageSize();
+
+/**
+ * @brief Reserve address space without backing it with physical memory
+ * @param size Number of bytes to reserve (rounded up to page size)
+ * @return Base of the reserved range, or nullptr on failure
+ *
+ * @note Reserved pages are inaccessible until committed
+ */
+ENJIN_API void* Reserve(usize size);
+
+/**
+ * @brief Make a page-aligned sub-range of a reservation readable/writable
+ * @return true on success
+ */
+ENJIN_API bool Commit(void* ptr, usize size);
+
+/**
+ * @brief Return the physical pages of a committed range to the OS
+ *
+ * The range stays reserved and must be committed again before use.
+ */
+ENJIN_API void Decommit(void* ptr, usize size);
+
+/**
+ * @brief Release a range obtained from Reserve() or Map()
+ */
+ENJIN_API void Release(void* ptr, usize size);
+
+/**
+ * @brief Reserve and commit a readable/writable range in one step
+ * @param size Number of bytes (rounded up to page size)
+ * @param alignment Required base alignment, power of two (may exceed page size)
+ * @return Base of the mapping, or nullptr on failure
+ *
+ * @note Fresh pages are zero-filled by the OS
+ */
+ENJIN_API void* Map(usize size, usize alignment = 0);
+
+/**
+ * @brief Release a range obtained from Map()
+ */
+ENJIN_API void Unmap(void* ptr, usize size);
+
+/**
+ * @brief Resize a mapping without copying its contents
+ *
+ * Grows in place when the following address space is free; otherwise moves
+ * the page tables to a new range aligned to `alignment` (mremap on Linux).
+ * Shrinking always happens in place and returns the tail pages to the OS.
+ *
+ * @return New base address, or nullptr if the platform cannot remap
+ *         (the original mapping is left untouched in that case)
+ */
+ENJIN_API void* Remap(void* ptr, usize oldSize, usize newSize, usize alignment = 0);
+
+} // namespace VirtualMemory
+} // namespace Enjin
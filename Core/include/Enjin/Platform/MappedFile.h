@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Enjin/Platform/Platform.h"
+#include "Enjin/Platform/Types.h"
+#include <string>
+
+/**
+ * @file MappedFile.h
+ * @brief Read-only memory mapping of a whole file (mmap / MapViewOfFile)
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin::Platform {
+
+/**
+ * @brief A file mapped read-only into the address space
+ *
+ * Pages are read from disk on first touch, so opening is cheap regardless
+ * of the file size. The mapping stays valid until Close() or destruction.
+ */
+class ENJIN_API MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Maps the whole file; an empty file opens with no data
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return m_Open; }
+    const u8* GetData() const { return m_Data; }
+    usize GetSize() const { return m_Size; }
+
+private:
+    const u8* m_Data = nullptr;
+    usize m_Size = 0;
+    bool m_Open = false;
+#if defined(ENJIN_PLATFORM_WINDOWS)
+    void* m_File = nullptr;    // HANDLE
+    void* m_Mapping = nullptr; // HANDLE
+#endif
+};
+
+} // namespace Enjin::Platform
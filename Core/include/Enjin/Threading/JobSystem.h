@@ -0,0 +1,177 @@
+#pragma once
+
+#include "Enjin/Platform/Platform.h"
+#include "Enjin/Platform/Types.h"
+#include <algorithm>
+#include <atomic>
+
+/**
+ * @file JobSystem.h
+ * @brief Work-stealing job scheduler: jobs, counters, continuations and ParallelFor
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+
+using JobFunction = void (*)(void* data);
+
+struct JobContinuation;
+
+/**
+ * @brief Number of jobs still in flight
+ *
+ * Run() increments it when a job is queued and the job decrements it when it
+ * returns; JobSystem::Wait() returns once it reaches zero, and continuations
+ * attached with RunAfter() are queued at that moment.
+ */
+struct JobCounter {
+    // pending while the thread that released the last job queues the
+    // continuations (references taken meanwhile are added on top); the
+    // counter is only done, and may be destroyed, once pending is 0
+    static constexpr u32 FINISHING = 1u << 31;
+
+    std::atomic<u32> pending{0};
+    std::atomic<JobContinuation*> continuations{nullptr};
+
+    bool IsDone() const { return pending.load(std::memory_order_acquire) == 0; }
+};
+
+/**
+ * @brief A job queued once a counter reaches zero (see JobSystem::RunAfter)
+ *
+ * Owned by the caller and must stay alive until the job has been queued.
+ */
+struct JobContinuation {
+    JobFunction function = nullptr;
+    void* data = nullptr;
+    JobCounter* counter = nullptr;   // Optional, like Run()'s counter
+    JobContinuation* next = nullptr; // Internal
+};
+
+/**
+ * @brief Process-wide work-stealing scheduler
+ *
+ * Every worker, and the thread that called Initialize(), owns a Chase-Lev
+ * deque: it pushes and pops jobs at the bottom without locks while idle
+ * workers steal from the top. Other threads submit through a shared
+ * injection queue. Idle workers sleep until new work is pushed.
+ *
+ * Application initializes it with one worker per hardware thread beyond the
+ * main thread. Until Initialize() is called (tools, benchmarks) Run() executes
+ * jobs inline on the calling thread, so code built on it works either way.
+ *
+ * Jobs are a function pointer plus a data pointer: nothing is allocated per
+ * job, and the caller keeps data alive until the job's counter is done.
+ *
+ * Waiting never parks a worker: Wait() keeps executing other jobs until the
+ * counter is done, and RunAfter() chains work onto a counter with no waiting
+ * thread at all.
+ *
+ * @threadsafe Run, RunAfter, Wait and ParallelFor may be called from any
+ *             thread, including from inside jobs
+ *
+ * @example
+ * JobCounter counter;
+ * JobSystem::Run(&BuildClusters, &clusterArgs, &counter);
+ * JobSystem::Run(&CullLights, &lightArgs, &counter);
+ * JobSystem::Wait(counter);
+ */
+class ENJIN_API JobSystem {
+public:
+    // Jobs a thread's deque holds; once full, Run() executes inline
+    static constexpr u32 DEQUE_CAPACITY = 4096;
+
+    /**
+     * @brief Start the worker threads
+     * @param workerCount 0 = hardware threads minus one (the main thread)
+     */
+    static void Initialize(u32 workerCount = 0);
+
+    // Finishes queued jobs, then joins the workers
+    static void Shutdown();
+
+    static bool IsInitialized();
+    static u32  GetWorkerCount();
+
+    /**
+     * @brief Queue function(data)
+     * @param counter Optional; incremented now, decremented when the job returns
+     */
+    static void Run(JobFunction function, void* data, JobCounter* counter = nullptr);
+
+    /**
+     * @brief Queue continuation once dependency reaches zero
+     *
+     * Queued immediately if dependency is already done. continuation.counter
+     * is incremented now, so waiting on it also covers the dependency.
+     * dependency must stay alive until its continuations have been queued,
+     * which is guaranteed once Wait(dependency) has returned.
+     */
+    static void RunAfter(JobCounter& dependency, JobContinuation& continuation);
+
+    /**
+     * @brief Return once counter is done, executing other jobs in the meantime
+     *
+     * Safe to call from a job: the waiting worker keeps pulling work from its
+     * own deque, the shared queue and other workers instead of sleeping.
+     */
+    static void Wait(JobCounter& counter);
+
+    /**
+     * @brief Call func(begin, end) over [0, count), possibly concurrently
+     *
+     * Threads claim guided ranges from a shared cursor: a share of what is
+     * left (large at first, smaller towards the end), never below grainSize.
+     * Helper jobs go onto the caller's deque, so only idle workers pick them
+     * up. The calling thread takes ranges too and returns when all are done.
+     *
+     * @param grainSize Minimum indices per call; 0 picks one from count
+     */
+    template<typename Func>
+    static void ParallelFor(usize count, Func&& func, usize grainSize = 0) {
+        if (count == 0) {
+            return;
+        }
+        const usize threads = static_cast<usize>(GetWorkerCount()) + 1;
+        if (grainSize == 0) {
+            grainSize = std::max<usize>(count / (threads * 64), 1);
+        }
+        if (count <= grainSize || !IsInitialized()) {
+            func(usize(0), count);
+            return;
+        }
+
+        struct Loop {
+            Func* func;
+            usize count;
+            usize grainSize;
+            usize divisor; // 2 * threads: each claim takes half a thread's fair share
+            std::atomic<usize> next{0};
+
+            static void Claim(void* data) {
+                Loop& loop = *static_cast<Loop*>(data);
+                usize begin = loop.next.load(std::memory_order_relaxed);
+                while (begin < loop.count) {
+                    const usize size = std::max(loop.grainSize, (loop.count - begin) / loop.divisor);
+                    const usize end = std::min(begin + size, loop.count);
+                    if (loop.next.compare_exchange_weak(begin, end, std::memory_order_relaxed)) {
+                        (*loop.func)(begin, end);
+                        begin = loop.next.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+        };
+
+        Loop loop{ &func, count, grainSize, threads * 2 };
+        JobCounter counter;
+        const usize helpers = std::min((count + grainSize - 1) / grainSize, threads) - 1;
+        for (usize i = 0; i < helpers; ++i) {
+            Run(&Loop::Claim, &loop, &counter);
+        }
+        Loop::Claim(&loop);
+        Wait(counter);
+    }
+};
+
+} // namespace Enjin
@@ -1,7 +1,10 @@
 #include "Enjin/Core/Application.h"
 #include "Enjin/Logging/Log.h"
+#include "Enjin/Memory/FrameAllocator.h"
+#include "Enjin/Memory/MemoryTracker.h"
 #include "Enjin/Platform/Window.h"
 #include "Enjin/Platform/Paths.h"
+#include "Enjin/Threading/JobSystem.h"
 #include <chrono>
 #include <iostream>
 #undef CreateWindow
@@ -24,9 +27,13 @@ extern Window* CreateWindow(const WindowDesc& desc);
 extern void DestroyWindow(Window* window);
 
 Application::Application() {
+    // Created up front so Initialize() and user constructors can already use it
+    m_FrameAllocator = new FrameAllocator();
+    SetFrameAllocator(m_FrameAllocator);
 }
 
 Application::~Application() {
+    delete m_FrameAllocator; // Unregisters itself from GetFrameAllocator()
 }
 
 int Application::Run() {
@@ -65,6 +72,8 @@ void Application::InitializeEngine() {
 
     Logger::Get().Initialize();
     ENJIN_LOG_INFO(Core, "Initializing Enjin Engine...");
+
+    JobSystem::Initialize();
     
     // Create window
     WindowDesc windowDesc;
@@ -100,6 +109,8 @@ void Application::ShutdownEngine() {
         DestroyWindow(m_Window);
         m_Window = nullptr;
     }
+
+    JobSystem::Shutdown();
     
     Logger::Get().Shutdown();
 }
@@ -113,6 +124,12 @@ void Application::MainLoop() {
         f32 deltaTime = static_cast<f32>(deltaTimeNs.count()) / 1'000'000'000.0f;
         lastTime = currentTime;
 
+        // Recycle the scratch arena of the oldest frame in flight
+        m_FrameAllocator->BeginFrame();
+
+        // Sample per-tag peaks and warn about blown memory budgets
+        MemoryTracker::Update();
+
         // Update window events
         if (m_Window) {
             m_Window->PollEvents();
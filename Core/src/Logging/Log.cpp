@@ -1,9 +1,9 @@
 #include "Enjin/Logging/Log.h"
+#include "Enjin/Memory/MemoryTracker.h"
 #include <cstdarg>
 #include <ctime>
 #include <iostream>
-#include <iomanip>
-#include <sstream>
+#include <algorithm>
 #include <cstring>
 
 namespace Enjin {
@@ -76,19 +76,19 @@ void Logger::SetCategoryEnabled(LogCategory category, bool enabled) {
 }
 
 void Logger::Log(LogLevel level, LogCategory category, const char* file, u32 line, const char* function, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    Write(level, category, file, line, function, format, args);
+    va_end(args);
+}
+
+void Logger::Write(LogLevel level, LogCategory category, const char* file, u32 line, const char* function, const char* format, va_list args) {
     std::lock_guard<std::mutex> lock(m_Mutex);
 
     if (!m_Initialized || level < m_MinLogLevel || !m_CategoryEnabled[static_cast<usize>(category)]) {
         return;
     }
-
-    // Format the message
-    va_list args;
-    va_start(args, format);
-    
-    char buffer[4096];
-    vsnprintf(buffer, sizeof(buffer), format, args);
-    va_end(args);
+    MemoryTagScope memoryTag(MemoryTag::Log);
 
     // Get filename from path
     const char* filename = file;
@@ -100,26 +100,32 @@ void Logger::Log(LogLevel level, LogCategory category, const char* file, u32 lin
         filename = lastSlash + 1;
     }
 
-    // Format log entry
-    std::stringstream ss;
-    ss << "[" << GetTimestamp() << "] "
-       << "[" << GetLogLevelString(level) << "] "
-       << "[" << GetCategoryString(category) << "] "
-       << filename << ":" << line << " (" << function << ") "
-       << buffer << std::endl;
-
-    std::string logEntry = ss.str();
+    char timestamp[32];
+    GetTimestamp(timestamp, sizeof(timestamp));
+
+    // Format log entry: header, then the message, truncated to fit with its newline
+    char entry[4096];
+    constexpr usize capacity = sizeof(entry) - 1; // Room for the newline
+    int header = snprintf(entry, capacity, "[%s] [%s] [%s] %s:%u (%s) ",
+                          timestamp, GetLogLevelString(level), GetCategoryString(category),
+                          filename, line, function);
+    usize length = header < 0 ? 0 : std::min(static_cast<usize>(header), capacity - 1);
+    int message = vsnprintf(entry + length, capacity - length, format, args);
+    if (message > 0) {
+        length = std::min(length + static_cast<usize>(message), capacity - 1);
+    }
+    entry[length++] = '\n';
 
     // Output to console
     if (level >= LogLevel::Error) {
-        std::cerr << logEntry;
+        std::cerr.write(entry, static_cast<std::streamsize>(length));
     } else {
-        std::cout << logEntry;
+        std::cout.write(entry, static_cast<std::streamsize>(length));
     }
 
     // Output to file
     if (m_LogFile && m_LogFile->is_open()) {
-        *m_LogFile << logEntry;
+        m_LogFile->write(entry, static_cast<std::streamsize>(length));
         m_LogFile->flush();
     }
 }
@@ -127,58 +133,46 @@ void Logger::Log(LogLevel level, LogCategory category, const char* file, u32 lin
 void Logger::Trace(LogCategory category, const char* file, u32 line, const char* function, const char* format, ...) {
     va_list args;
     va_start(args, format);
-    char buffer[4096];
-    vsnprintf(buffer, sizeof(buffer), format, args);
+    Write(LogLevel::Trace, category, file, line, function, format, args);
     va_end(args);
-    Log(LogLevel::Trace, category, file, line, function, "%s", buffer);
 }
 
 void Logger::Debug(LogCategory category, const char* file, u32 line, const char* function, const char* format, ...) {
     va_list args;
     va_start(args, format);
-    char buffer[4096];
-    vsnprintf(buffer, sizeof(buffer), format, args);
+    Write(LogLevel::Debug, category, file, line, function, format, args);
     va_end(args);
-    Log(LogLevel::Debug, category, file, line, function, "%s", buffer);
 }
 
 void Logger::Info(LogCategory category, const char* file, u32 line, const char* function, const char* format, ...) {
     va_list args;
     va_start(args, format);
-    char buffer[4096];
-    vsnprintf(buffer, sizeof(buffer), format, args);
+    Write(LogLevel::Info, category, file, line, function, format, args);
     va_end(args);
-    Log(LogLevel::Info, category, file, line, function, "%s", buffer);
 }
 
 void Logger::Warn(LogCategory category, const char* file, u32 line, const char* function, const char* format, ...) {
     va_list args;
     va_start(args, format);
-    char buffer[4096];
-    vsnprintf(buffer, sizeof(buffer), format, args);
+    Write(LogLevel::Warn, category, file, line, function, format, args);
     va_end(args);
-    Log(LogLevel::Warn, category, file, line, function, "%s", buffer);
 }
 
 void Logger::Error(LogCategory category, const char* file, u32 line, const char* function, const char* format, ...) {
     va_list args;
     va_start(args, format);
-    char buffer[4096];
-    vsnprintf(buffer, sizeof(buffer), format, args);
+    Write(LogLevel::Error, category, file, line, function, format, args);
     va_end(args);
-    Log(LogLevel::Error, category, file, line, function, "%s", buffer);
 }
 
 void Logger::Fatal(LogCategory category, const char* file, u32 line, const char* function, const char* format, ...) {
     va_list args;
     va_start(args, format);
-    char buffer[4096];
-    vsnprintf(buffer, sizeof(buffer), format, args);
+    Write(LogLevel::Fatal, category, file, line, function, format, args);
     va_end(args);
-    Log(LogLevel::Fatal, category, file, line, function, "%s", buffer);
 }
 
-std::string Logger::GetLogLevelString(LogLevel level) const {
+const char* Logger::GetLogLevelString(LogLevel level) const {
     switch (level) {
         case LogLevel::Trace: return "TRACE";
         case LogLevel::Debug: return "DEBUG";
@@ -190,7 +184,7 @@ std::string Logger::GetLogLevelString(LogLevel level) const {
     }
 }
 
-std::string Logger::GetCategoryString(LogCategory category) const {
+const char* Logger::GetCategoryString(LogCategory category) const {
     switch (category) {
         case LogCategory::Core:     return "CORE  ";
         case LogCategory::Renderer: return "RENDER";
@@ -204,13 +198,12 @@ std::string Logger::GetCategoryString(LogCategory category) const {
     }
 }
 
-std::string Logger::GetTimestamp() const {
-    auto now = std::time(nullptr);
-    auto tm = *std::localtime(&now);
-    
-    std::stringstream ss;
-    ss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
-    return ss.str();
+void Logger::GetTimestamp(char* buffer, usize size) const {
+    std::time_t now = std::time(nullptr);
+    std::tm tm = *std::localtime(&now);
+    if (std::strftime(buffer, size, "%Y-%m-%d %H:%M:%S", &tm) == 0 && size > 0) {
+        buffer[0] = '\0';
+    }
 }
 
 } // namespace Enjin
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Enjin/Platform/Platform.h"
+#include "Enjin/Platform/Types.h"
+#include <atomic>
+
+/**
+ * @file AtomicCounters.h
+ * @brief Internal helpers for the memory subsystem's statistics counters
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+
+// For counters with a single writer: a relaxed load/store pair avoids a
+// locked read-modify-write, and readers on other threads still see whole values
+ENJIN_FORCE_INLINE void AddRelaxed(std::atomic<i64>& counter, i64 delta) {
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+} // namespace Enjin
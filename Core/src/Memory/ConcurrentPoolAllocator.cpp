@@ -0,0 +1,286 @@
+#include "Enjin/Memory/ConcurrentPoolAllocator.h"
+#include "Enjin/Memory/VirtualMemory.h"
+#include "AtomicCounters.h"
+#include <algorithm>
+#include <cassert>
+
+namespace Enjin {
+
+namespace {
+
+constexpr usize COMMIT_GRANULARITY = 64 * 1024;
+constexpr u32 NO_THREAD_SLOT = ~0u;
+
+usize RoundUp(usize value, usize alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Process-wide thread slots shared by every pool. A slot is held from a
+// thread's first pool access until it exits, so at most one live thread uses
+// a given cache index; objects left in a dead thread's cache are inherited by
+// the next thread that gets its slot.
+std::mutex s_SlotMutex;
+bool s_SlotUsed[ConcurrentPoolAllocator::MAX_THREAD_CACHES] = {};
+
+struct ThreadSlot {
+    u32 index = NO_THREAD_SLOT;
+    bool acquired = false;
+
+    u32 Acquire() {
+        acquired = true;
+        std::lock_guard<std::mutex> lock(s_SlotMutex);
+        for (u32 i = 0; i < ConcurrentPoolAllocator::MAX_THREAD_CACHES; ++i) {
+            if (!s_SlotUsed[i]) {
+                s_SlotUsed[i] = true;
+                index = i;
+                break;
+            }
+        }
+        return index;
+    }
+
+    ~ThreadSlot() {
+        if (index != NO_THREAD_SLOT) {
+            std::lock_guard<std::mutex> lock(s_SlotMutex);
+            s_SlotUsed[index] = false;
+        }
+    }
+};
+
+thread_local ThreadSlot t_Slot;
+
+} // namespace
+
+ConcurrentPoolAllocator::ConcurrentPoolAllocator(const ConcurrentPoolDesc& desc)
+    : m_ObjectSize(desc.objectSize)
+    , m_Alignment(std::max(desc.alignment, alignof(FreeBlock)))
+    , m_MaxObjects(std::min(desc.maxObjects, ~0u - 1))
+    , m_BatchSize(std::max(desc.batchSize, 1u)) {
+    assert(m_ObjectSize > 0 && "ConcurrentPoolAllocator needs an object size");
+    assert((m_Alignment & (m_Alignment - 1)) == 0 && "Alignment must be a power of two");
+    assert(m_Alignment <= VirtualMemory::GetPageSize() && "Alignment cannot exceed the page size");
+
+    m_Stride = RoundUp(std::max(m_ObjectSize, sizeof(FreeBlock)), m_Alignment);
+    m_Reserved = RoundUp(static_cast<usize>(m_MaxObjects) * m_Stride, VirtualMemory::GetPageSize());
+    m_Memory = static_cast<u8*>(VirtualMemory::Reserve(m_Reserved));
+    if (!m_Memory) {
+        m_Reserved = 0;
+        m_MaxObjects = 0;
+    }
+}
+
+ConcurrentPoolAllocator::ConcurrentPoolAllocator(usize objectSize, u32 maxObjects)
+    : ConcurrentPoolAllocator(ConcurrentPoolDesc{ objectSize, DEFAULT_ALIGNMENT, maxObjects }) {
+}
+
+ConcurrentPoolAllocator::~ConcurrentPoolAllocator() {
+    VirtualMemory::Release(m_Memory, m_Reserved);
+}
+
+u32 ConcurrentPoolAllocator::IndexOf(const void* ptr) const {
+    return static_cast<u32>((static_cast<const u8*>(ptr) - m_Memory) / m_Stride);
+}
+
+ConcurrentPoolAllocator::FreeBlock* ConcurrentPoolAllocator::BlockAt(u32 index) const {
+    return reinterpret_cast<FreeBlock*>(m_Memory + static_cast<usize>(index) * m_Stride);
+}
+
+ConcurrentPoolAllocator::ThreadCache* ConcurrentPoolAllocator::GetThreadCache() {
+    ThreadSlot& slot = t_Slot;
+    u32 index = slot.index;
+    if (index == NO_THREAD_SLOT) [[unlikely]] {
+        if (slot.acquired) {
+            return nullptr; // Ran out of slots earlier; stay on the shared path
+        }
+        index = slot.Acquire();
+        if (index == NO_THREAD_SLOT) {
+            return nullptr;
+        }
+    }
+    return &m_Caches[index];
+}
+
+void ConcurrentPoolAllocator::PushBatch(FreeBlock* head, u32 count) {
+    head->count = count;
+    const u32 index = IndexOf(head) + 1;
+    std::atomic_ref<u32> link(head->nextBatch);
+
+    u64 old = m_GlobalHead.load(std::memory_order_relaxed);
+    do {
+        link.store(static_cast<u32>(old), std::memory_order_relaxed);
+    } while (!m_GlobalHead.compare_exchange_weak(old, Pack(index, static_cast<u32>(old >> 32) + 1),
+                                                 std::memory_order_release, std::memory_order_relaxed));
+}
+
+ConcurrentPoolAllocator::FreeBlock* ConcurrentPoolAllocator::PopBatch(u32& outCount) {
+    u64 old = m_GlobalHead.load(std::memory_order_acquire);
+    for (;;) {
+        const u32 index = static_cast<u32>(old);
+        if (index == 0) {
+            return nullptr;
+        }
+
+        // The head may be popped and reused by another thread before our CAS;
+        // the read then returns garbage, but the tag makes the CAS fail.
+        FreeBlock* head = BlockAt(index - 1);
+        const u32 next = std::atomic_ref<u32>(head->nextBatch).load(std::memory_order_relaxed);
+        if (m_GlobalHead.compare_exchange_weak(old, Pack(next, static_cast<u32>(old >> 32) + 1),
+                                               std::memory_order_acquire, std::memory_order_acquire)) {
+            outCount = head->count;
+            return head;
+        }
+    }
+}
+
+ConcurrentPoolAllocator::FreeBlock* ConcurrentPoolAllocator::CarveBatch(u32& outCount) {
+    std::lock_guard<std::mutex> lock(m_GrowMutex);
+
+    // Another thread may have refilled the global stack while we waited
+    if (FreeBlock* batch = PopBatch(outCount)) {
+        return batch;
+    }
+
+    const u32 carved = m_Carved.load(std::memory_order_relaxed);
+    const u32 count = std::min(m_BatchSize, m_MaxObjects - carved);
+    if (count == 0) {
+        return nullptr;
+    }
+
+    const usize end = static_cast<usize>(carved + count) * m_Stride;
+    if (end > m_Committed) {
+        const usize newCommitted = std::min(RoundUp(end, COMMIT_GRANULARITY), m_Reserved);
+        if (!VirtualMemory::Commit(m_Memory + m_Committed, newCommitted - m_Committed)) {
+            return nullptr;
+        }
+        m_Committed = newCommitted;
+    }
+
+    FreeBlock* head = BlockAt(carved);
+    for (u32 i = 0; i < count; ++i) {
+        BlockAt(carved + i)->next = (i + 1 < count) ? BlockAt(carved + i + 1) : nullptr;
+    }
+    m_Carved.store(carved + count, std::memory_order_relaxed);
+
+    outCount = count;
+    return head;
+}
+
+void* ConcurrentPoolAllocator::Allocate(usize size, usize alignment) {
+    assert(size <= m_ObjectSize && "Allocation exceeds pool object size");
+    assert(alignment <= m_Alignment && "Allocation alignment exceeds pool alignment");
+    if (size > m_ObjectSize || alignment > m_Alignment) {
+        return nullptr;
+    }
+
+    ThreadCache* cache = GetThreadCache();
+    if (cache) [[likely]] {
+        if (!cache->head) [[unlikely]] {
+            u32 count = 0;
+            FreeBlock* batch = PopBatch(count);
+            if (!batch) {
+                batch = CarveBatch(count);
+                if (!batch) {
+                    return nullptr;
+                }
+            }
+            cache->head = batch;
+            cache->count = count;
+        }
+
+        FreeBlock* block = cache->head;
+        cache->head = block->next;
+        --cache->count;
+        AddRelaxed(cache->liveObjects, 1);
+        return block;
+    }
+
+    // No thread cache: take one object, hand the rest of the batch back
+    u32 count = 0;
+    FreeBlock* batch = PopBatch(count);
+    if (!batch) {
+        batch = CarveBatch(count);
+        if (!batch) {
+            return nullptr;
+        }
+    }
+    if (count > 1) {
+        PushBatch(batch->next, count - 1);
+    }
+    m_SharedLiveObjects.fetch_add(1, std::memory_order_relaxed);
+    return batch;
+}
+
+void ConcurrentPoolAllocator::Deallocate(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    assert(static_cast<u8*>(ptr) >= m_Memory && static_cast<u8*>(ptr) < m_Memory + m_Reserved &&
+           "Pointer does not belong to this pool");
+
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    ThreadCache* cache = GetThreadCache();
+    if (cache) [[likely]] {
+        block->next = cache->head;
+        cache->head = block;
+        ++cache->count;
+        AddRelaxed(cache->liveObjects, -1);
+
+        if (cache->count >= m_BatchSize * 2) [[unlikely]] {
+            // Detach one batch from the top of the cache and publish it
+            FreeBlock* tail = block;
+            for (u32 i = 1; i < m_BatchSize; ++i) {
+                tail = tail->next;
+            }
+            cache->head = tail->next;
+            cache->count -= m_BatchSize;
+            tail->next = nullptr;
+            PushBatch(block, m_BatchSize);
+        }
+        return;
+    }
+
+    block->next = nullptr;
+    PushBatch(block, 1);
+    m_SharedLiveObjects.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void ConcurrentPoolAllocator::FlushThreadCache() {
+    ThreadCache* cache = GetThreadCache();
+    if (!cache) {
+        return;
+    }
+
+    while (cache->head) {
+        FreeBlock* head = cache->head;
+        FreeBlock* tail = head;
+        u32 count = 1;
+        while (count < m_BatchSize && tail->next) {
+            tail = tail->next;
+            ++count;
+        }
+        cache->head = tail->next;
+        tail->next = nullptr;
+        PushBatch(head, count);
+    }
+    cache->count = 0;
+}
+
+usize ConcurrentPoolAllocator::GetTotalAllocated() const {
+    // Objects migrate between threads, so individual counters can go negative
+    i64 live = m_SharedLiveObjects.load(std::memory_order_relaxed);
+    for (const ThreadCache& cache : m_Caches) {
+        live += cache.liveObjects.load(std::memory_order_relaxed);
+    }
+    return live > 0 ? static_cast<usize>(live) * m_Stride : 0;
+}
+
+usize ConcurrentPoolAllocator::GetTotalCapacity() const {
+    return static_cast<usize>(m_Carved.load(std::memory_order_relaxed)) * m_Stride;
+}
+
+usize ConcurrentPoolAllocator::GetAllocationSize(const void* ptr) const {
+    const u8* bytes = static_cast<const u8*>(ptr);
+    return (bytes >= m_Memory && bytes < m_Memory + m_Reserved) ? m_ObjectSize : 0;
+}
+
+} // namespace Enjin
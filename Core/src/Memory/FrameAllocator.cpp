@@ -0,0 +1,112 @@
+#include "Enjin/Memory/FrameAllocator.h"
+#include <cassert>
+
+namespace Enjin {
+
+namespace {
+
+// The calling thread's current chunk. Keyed by allocator and frame serial so
+// a BeginFrame() anywhere invalidates every thread's chunk without touching it.
+struct ThreadChunk {
+    const FrameAllocator* owner;
+    u64 frameSerial;
+    u8* cursor;
+    u8* end;
+};
+
+thread_local ThreadChunk t_Chunk{};
+
+std::atomic<u64> s_NextFrameSerial{1};
+
+FrameAllocator* g_FrameAllocator = nullptr;
+
+} // namespace
+
+FrameAllocator::FrameAllocator(const FrameAllocatorDesc& desc)
+    : m_ChunkSize(desc.threadChunkSize) {
+    assert(desc.frameCount > 0 && "FrameAllocator needs at least one frame");
+    assert(desc.arena.reserveSize > 0 && "FrameAllocator needs a virtual arena reservation");
+
+    m_Frames.reserve(desc.frameCount);
+    for (u32 i = 0; i < desc.frameCount; ++i) {
+        m_Frames.push_back(std::make_unique<LinearAllocator>(desc.arena));
+    }
+    m_FrameSerial.store(s_NextFrameSerial.fetch_add(1, std::memory_order_relaxed), std::memory_order_release);
+}
+
+FrameAllocator::~FrameAllocator() {
+    if (g_FrameAllocator == this) {
+        g_FrameAllocator = nullptr;
+    }
+}
+
+void FrameAllocator::BeginFrame() {
+    m_FrameIndex = (m_FrameIndex + 1) % static_cast<u32>(m_Frames.size());
+    m_Frames[m_FrameIndex]->Reset();
+    m_FrameSerial.store(s_NextFrameSerial.fetch_add(1, std::memory_order_relaxed), std::memory_order_release);
+}
+
+void* FrameAllocator::Allocate(usize size, usize alignment) {
+    ThreadChunk& chunk = t_Chunk;
+    const u64 frameSerial = m_FrameSerial.load(std::memory_order_acquire);
+
+    if (chunk.owner == this && chunk.frameSerial == frameSerial) [[likely]] {
+        u8* ptr = chunk.cursor + GetAlignmentOffset(chunk.cursor, alignment);
+        if (ptr + size <= chunk.end) {
+            chunk.cursor = ptr + size;
+            return ptr;
+        }
+    }
+    return AllocateSlow(size, alignment, frameSerial);
+}
+
+void* FrameAllocator::AllocateSlow(usize size, usize alignment, u64 frameSerial) {
+    std::lock_guard<std::mutex> lock(m_CarveMutex);
+    LinearAllocator& frame = *m_Frames[m_FrameIndex];
+
+    // Big requests get their own block so they don't throw away the current chunk
+    if (size + alignment > m_ChunkSize / 2) {
+        return frame.Allocate(size, alignment);
+    }
+
+    u8* memory = static_cast<u8*>(frame.Allocate(m_ChunkSize, CACHE_LINE_SIZE));
+    if (!memory) {
+        return nullptr;
+    }
+
+    ThreadChunk& chunk = t_Chunk;
+    chunk.owner = this;
+    chunk.frameSerial = frameSerial;
+    chunk.end = memory + m_ChunkSize;
+
+    u8* ptr = memory + GetAlignmentOffset(memory, alignment);
+    chunk.cursor = ptr + size;
+    return ptr;
+}
+
+void FrameAllocator::Deallocate(void* ptr) {
+    // Frame memory is released wholesale by BeginFrame()
+    (void)ptr;
+}
+
+usize FrameAllocator::GetTotalAllocated() const {
+    return m_Frames[m_FrameIndex]->GetTotalAllocated();
+}
+
+usize FrameAllocator::GetTotalCapacity() const {
+    usize total = 0;
+    for (const auto& frame : m_Frames) {
+        total += frame->GetTotalCapacity();
+    }
+    return total;
+}
+
+FrameAllocator* GetFrameAllocator() {
+    return g_FrameAllocator;
+}
+
+void SetFrameAllocator(FrameAllocator* allocator) {
+    g_FrameAllocator = allocator;
+}
+
+} // namespace Enjin
@@ -1,46 +1,210 @@
 #include "Enjin/Memory/Memory.h"
+#include "Enjin/Memory/MemoryTracker.h"
+#include "Enjin/Memory/ThreadCachingAllocator.h"
+#include "Enjin/Memory/VirtualMemory.h"
 #include <cstring>
 #include <cassert>
 #include <cstdlib>
 
+// Tag and size every block from Allocate() so MemoryTracker can attribute frees
+#ifndef ENJIN_MEMORY_TRACKING
+    #define ENJIN_MEMORY_TRACKING 1
+#endif
+
 namespace Enjin {
 
-// Default allocator (uses malloc/free for now, can be replaced)
+// User-installed default allocator; nullptr means the built-in ThreadCachingAllocator
 static IAllocator* g_DefaultAllocator = nullptr;
 
-void* Allocate(usize size, usize alignment) {
+namespace {
+
+void* RawAllocate(usize size, usize alignment) {
     if (g_DefaultAllocator) {
         return g_DefaultAllocator->Allocate(size, alignment);
     }
-    // Fallback to aligned malloc
-#ifdef _WIN32
-    return _aligned_malloc(size, alignment);
-#else
-    void* ptr = nullptr;
-    posix_memalign(&ptr, alignment, size);
-    return ptr;
+    return ThreadCachingAllocator::Get().Allocate(size, alignment);
+}
+
+void RawDeallocate(void* ptr) {
+    ThreadCachingAllocator& builtin = ThreadCachingAllocator::Get();
+    // Memory handed out before a custom allocator was installed still goes home
+    if (g_DefaultAllocator && !builtin.Owns(ptr)) {
+        g_DefaultAllocator->Deallocate(ptr);
+        return;
+    }
+    builtin.Deallocate(ptr);
+}
+
+void* RawReallocate(void* ptr, usize newSize, usize alignment) {
+    ThreadCachingAllocator& builtin = ThreadCachingAllocator::Get();
+    if (g_DefaultAllocator && !builtin.Owns(ptr)) {
+        return g_DefaultAllocator->Reallocate(ptr, newSize, alignment);
+    }
+    return builtin.Reallocate(ptr, newSize, alignment);
+}
+
+usize RawGetAllocationSize(const void* ptr) {
+    ThreadCachingAllocator& builtin = ThreadCachingAllocator::Get();
+    if (g_DefaultAllocator && !builtin.Owns(ptr)) {
+        return g_DefaultAllocator->GetAllocationSize(ptr);
+    }
+    return builtin.GetAllocationSize(ptr);
+}
+
+#if ENJIN_MEMORY_TRACKING
+// Sits directly below every pointer returned by Allocate(). The block starts
+// `offset` bytes earlier; offset is a multiple of the alignment so the user
+// pointer keeps it.
+struct AllocationHeader {
+    u64 size;
+    u32 offset;
+    MemoryTag tag;
+    u8 padding[3];
+};
+static_assert(sizeof(AllocationHeader) == DEFAULT_ALIGNMENT, "Header must preserve the default alignment");
+
+ENJIN_FORCE_INLINE AllocationHeader* GetHeader(const void* ptr) {
+    return reinterpret_cast<AllocationHeader*>(const_cast<u8*>(static_cast<const u8*>(ptr)) - sizeof(AllocationHeader));
+}
+
+ENJIN_FORCE_INLINE usize GetHeaderOffset(usize alignment) {
+    return alignment > sizeof(AllocationHeader) ? alignment : sizeof(AllocationHeader);
+}
+
+// C heap blocks passed to Deallocate() have no header; the built-in heap can
+// recognise them (a custom default allocator is trusted to own everything)
+ENJIN_FORCE_INLINE bool IsForeign(const void* ptr) {
+    return !g_DefaultAllocator && !ThreadCachingAllocator::Get().Owns(ptr);
+}
 #endif
+
+} // namespace
+
+#if ENJIN_MEMORY_TRACKING
+
+void* Allocate(usize size, usize alignment) {
+    const usize offset = GetHeaderOffset(alignment);
+    // At least one byte past the header, so the user pointer always lies inside
+    // the block (IsForeign looks it up by that pointer)
+    u8* block = static_cast<u8*>(RawAllocate(offset + (size ? size : 1), alignment));
+    if (!block) {
+        return nullptr;
+    }
+    u8* ptr = block + offset;
+    AllocationHeader* header = GetHeader(ptr);
+    header->size = size;
+    header->offset = static_cast<u32>(offset);
+    header->tag = MemoryTracker::GetCurrentTag();
+    MemoryTracker::RecordAllocation(header->tag, size);
+    return ptr;
 }
 
 void Deallocate(void* ptr) {
-    if (g_DefaultAllocator && ptr) {
-        g_DefaultAllocator->Deallocate(ptr);
-    } else if (ptr) {
-#ifdef _WIN32
-        _aligned_free(ptr);
-#else
+    if (!ptr) {
+        return;
+    }
+    if (IsForeign(ptr)) [[unlikely]] {
         std::free(ptr);
-#endif
+        return;
     }
+    const AllocationHeader* header = GetHeader(ptr);
+    MemoryTracker::RecordDeallocation(header->tag, static_cast<usize>(header->size));
+    RawDeallocate(static_cast<u8*>(ptr) - header->offset);
 }
 
 void* Reallocate(void* ptr, usize newSize, usize alignment) {
-    void* newPtr = Allocate(newSize, alignment);
+    if (!ptr) {
+        return Allocate(newSize, alignment);
+    }
+    if (newSize == 0) {
+        Deallocate(ptr);
+        return nullptr;
+    }
+    if (IsForeign(ptr)) [[unlikely]] {
+        return std::realloc(ptr, newSize);
+    }
+
+    const AllocationHeader header = *GetHeader(ptr);
+    if (GetHeaderOffset(alignment) > header.offset) {
+        // Stronger alignment than the block was made for: move it, keeping its tag
+        MemoryTagScope memoryTag(header.tag);
+        void* newPtr = Allocate(newSize, alignment);
+        if (newPtr) {
+            MemoryCopy(newPtr, ptr, header.size < newSize ? static_cast<usize>(header.size) : newSize);
+            Deallocate(ptr);
+        }
+        return newPtr;
+    }
+
+    // The header travels with the block, which stays charged to its original tag
+    u8* block = static_cast<u8*>(RawReallocate(static_cast<u8*>(ptr) - header.offset, newSize + header.offset, alignment));
+    if (!block) {
+        return nullptr;
+    }
+    u8* newPtr = block + header.offset;
+    GetHeader(newPtr)->size = newSize;
+    MemoryTracker::RecordDeallocation(header.tag, static_cast<usize>(header.size));
+    MemoryTracker::RecordAllocation(header.tag, newSize);
+    return newPtr;
+}
+
+usize GetAllocationSize(const void* ptr) {
+    if (!ptr || IsForeign(ptr)) {
+        return 0;
+    }
+    const usize offset = GetHeader(ptr)->offset;
+    const usize blockSize = RawGetAllocationSize(static_cast<const u8*>(ptr) - offset);
+    return blockSize > offset ? blockSize - offset : 0;
+}
+
+#else
+
+void* Allocate(usize size, usize alignment) {
+    return RawAllocate(size, alignment);
+}
+
+void Deallocate(void* ptr) {
     if (ptr) {
-        // Note: This is a simplified realloc - proper implementation would track size
-        MemoryCopy(newPtr, ptr, newSize);
+        RawDeallocate(ptr);
+    }
+}
+
+void* Reallocate(void* ptr, usize newSize, usize alignment) {
+    if (!ptr) {
+        return Allocate(newSize, alignment);
+    }
+    if (newSize == 0) {
         Deallocate(ptr);
+        return nullptr;
     }
+    return RawReallocate(ptr, newSize, alignment);
+}
+
+usize GetAllocationSize(const void* ptr) {
+    return ptr ? RawGetAllocationSize(ptr) : 0;
+}
+
+#endif
+
+void* IAllocator::Reallocate(void* ptr, usize newSize, usize alignment) {
+    if (!ptr) {
+        return Allocate(newSize, alignment);
+    }
+
+    usize oldSize = GetAllocationSize(ptr);
+    bool aligned = GetAlignmentOffset(ptr, alignment) == 0;
+    if (aligned && oldSize >= newSize) {
+        return ptr;
+    }
+
+    void* newPtr = Allocate(newSize, alignment);
+    if (!newPtr) {
+        return nullptr;
+    }
+    // Allocators that cannot report sizes keep the old contract: the caller
+    // guarantees the old block holds at least newSize bytes.
+    MemoryCopy(newPtr, ptr, oldSize ? (oldSize < newSize ? oldSize : newSize) : newSize);
+    Deallocate(ptr);
     return newPtr;
 }
 
@@ -63,34 +227,92 @@ void MemoryZero(void* dest, usize size) {
 }
 
 IAllocator* GetDefaultAllocator() {
-    return g_DefaultAllocator;
+    return g_DefaultAllocator ? g_DefaultAllocator : &ThreadCachingAllocator::Get();
 }
 
 void SetDefaultAllocator(IAllocator* allocator) {
     g_DefaultAllocator = allocator;
 }
 
+// Shared reserve/commit helpers for the virtual-arena mode of stack and linear allocators
+namespace {
+
+u8* ReserveArena(VirtualArenaDesc& arena, usize& outSize) {
+    const usize pageSize = VirtualMemory::GetPageSize();
+    arena.reserveSize = (arena.reserveSize + pageSize - 1) & ~(pageSize - 1);
+    arena.commitGranularity = arena.commitGranularity < pageSize ? pageSize : arena.commitGranularity;
+    outSize = arena.reserveSize;
+    return static_cast<u8*>(VirtualMemory::Reserve(arena.reserveSize));
+}
+
+// Commit pages so that [0, end) is accessible. Pages are committed in
+// commitGranularity steps to keep the number of syscalls low.
+bool CommitArena(u8* memory, const VirtualArenaDesc& arena, usize& committed, usize end) {
+    if (end <= committed) {
+        return true;
+    }
+    usize target = ((end + arena.commitGranularity - 1) / arena.commitGranularity) * arena.commitGranularity;
+    if (target > arena.reserveSize) {
+        target = arena.reserveSize;
+    }
+    if (!VirtualMemory::Commit(memory + committed, target - committed)) {
+        return false;
+    }
+    committed = target;
+    return true;
+}
+
+void ResetArena(u8* memory, const VirtualArenaDesc& arena, usize& committed) {
+    if (!arena.decommitOnReset) {
+        return;
+    }
+    const usize pageSize = VirtualMemory::GetPageSize();
+    usize retain = (arena.retainOnReset + pageSize - 1) & ~(pageSize - 1);
+    if (committed > retain) {
+        VirtualMemory::Decommit(memory + retain, committed - retain);
+        committed = retain;
+    }
+}
+
+} // namespace
+
 // StackAllocator implementation
 StackAllocator::StackAllocator(usize size) 
     : m_Size(size), m_Offset(0) {
     m_Memory = static_cast<u8*>(std::malloc(size));
     assert(m_Memory && "Failed to allocate memory for StackAllocator");
+    m_Committed = size;
+}
+
+StackAllocator::StackAllocator(const VirtualArenaDesc& arena)
+    : m_Size(0), m_Offset(0), m_Arena(arena) {
+    m_Memory = ReserveArena(m_Arena, m_Size);
+    assert(m_Memory && "Failed to reserve address space for StackAllocator");
 }
 
 StackAllocator::~StackAllocator() {
-    std::free(m_Memory);
+    if (m_Arena.reserveSize) {
+        VirtualMemory::Release(m_Memory, m_Size);
+    } else {
+        std::free(m_Memory);
+    }
+}
+
+bool StackAllocator::EnsureCommitted(usize end) {
+    return !m_Arena.reserveSize || CommitArena(m_Memory, m_Arena, m_Committed, end);
 }
 
 void* StackAllocator::Allocate(usize size, usize alignment) {
     usize offset = GetAlignmentOffset(m_Memory + m_Offset, alignment);
     usize totalSize = size + offset;
     
-    if (m_Offset + totalSize > m_Size) {
+    if (m_Offset + totalSize > m_Size || !EnsureCommitted(m_Offset + totalSize)) {
         return nullptr; // Out of memory
     }
     
-    void* ptr = m_Memory + m_Offset + offset;
+    u8* ptr = m_Memory + m_Offset + offset;
     m_Offset += totalSize;
+    m_LastAllocation = ptr;
     return ptr;
 }
 
@@ -108,6 +330,40 @@ usize StackAllocator::GetTotalCapacity() const {
     return m_Size;
 }
 
+usize StackAllocator::GetAllocationSize(const void* ptr) const {
+    // Only the top block has a known extent; the rest are bounded by their successor
+    if (ptr && ptr == m_LastAllocation) {
+        return static_cast<usize>(m_Memory + m_Offset - m_LastAllocation);
+    }
+    return 0;
+}
+
+void* StackAllocator::Reallocate(void* ptr, usize newSize, usize alignment) {
+    if (!ptr) {
+        return Allocate(newSize, alignment);
+    }
+
+    u8* block = static_cast<u8*>(ptr);
+    if (block == m_LastAllocation && GetAlignmentOffset(block, alignment) == 0) {
+        // Top of stack: just move the end
+        usize end = static_cast<usize>(block - m_Memory) + newSize;
+        if (end > m_Size || !EnsureCommitted(end)) {
+            return nullptr;
+        }
+        m_Offset = end;
+        return block;
+    }
+
+    // Never copy past the top of the stack, whatever the caller claims
+    usize available = static_cast<usize>(m_Memory + m_Offset - block);
+    void* newPtr = Allocate(newSize, alignment);
+    if (!newPtr) {
+        return nullptr;
+    }
+    MemoryCopy(newPtr, block, available < newSize ? available : newSize);
+    return newPtr;
+}
+
 usize StackAllocator::GetMarker() const {
     return m_Offset;
 }
@@ -115,67 +371,159 @@ usize StackAllocator::GetMarker() const {
 void StackAllocator::FreeToMarker(usize marker) {
     assert(marker <= m_Offset);
     m_Offset = marker;
+    if (m_LastAllocation && m_LastAllocation >= m_Memory + marker) {
+        m_LastAllocation = nullptr;
+    }
 }
 
 void StackAllocator::Reset() {
     m_Offset = 0;
+    m_LastAllocation = nullptr;
+    if (m_Arena.reserveSize) {
+        ResetArena(m_Memory, m_Arena, m_Committed);
+    }
 }
 
 // PoolAllocator implementation
 PoolAllocator::PoolAllocator(usize objectSize, usize objectCount)
-    : m_ObjectSize(objectSize), m_ObjectCount(objectCount) {
+    : PoolAllocator(PoolAllocatorDesc{ objectSize, objectCount }) {
+}
+
+PoolAllocator::PoolAllocator(const PoolAllocatorDesc& desc)
+    : m_ObjectSize(desc.objectSize),
+      m_Alignment(desc.alignment < sizeof(FreeBlock) ? sizeof(FreeBlock) : desc.alignment),
+      m_MaxSlabs(desc.maxSlabs),
+      m_ReleaseEmptySlabs(desc.releaseEmptySlabs) {
+    assert((m_Alignment & (m_Alignment - 1)) == 0 && "PoolAllocator alignment must be a power of two");
+
     // Ensure object size is at least sizeof(FreeBlock)
-    m_ObjectSize = (m_ObjectSize < sizeof(FreeBlock)) ? sizeof(FreeBlock) : m_ObjectSize;
-    
-    m_Memory = static_cast<u8*>(std::malloc(m_ObjectSize * m_ObjectCount));
-    assert(m_Memory && "Failed to allocate memory for PoolAllocator");
-    
-    // Initialize free list
-    m_FreeList = reinterpret_cast<FreeBlock*>(m_Memory);
-    FreeBlock* current = m_FreeList;
-    for (usize i = 0; i < m_ObjectCount - 1; ++i) {
-        current->next = reinterpret_cast<FreeBlock*>(
-            m_Memory + (i + 1) * m_ObjectSize);
-        current = current->next;
+    usize objectSize = (m_ObjectSize < sizeof(FreeBlock)) ? sizeof(FreeBlock) : m_ObjectSize;
+    m_Stride = (objectSize + m_Alignment - 1) & ~(m_Alignment - 1);
+    m_HeaderSize = (sizeof(Slab) + m_Alignment - 1) & ~(m_Alignment - 1);
+
+    // Power-of-two slabs aligned to their size: ptr & ~(slabBytes - 1) is the header
+    usize objectsPerSlab = desc.objectsPerSlab ? desc.objectsPerSlab : 1;
+    m_SlabBytes = VirtualMemory::GetPageSize();
+    while (m_SlabBytes < m_HeaderSize + objectsPerSlab * m_Stride) {
+        m_SlabBytes <<= 1;
     }
-    current->next = nullptr;
+    m_ObjectsPerSlab = static_cast<u32>((m_SlabBytes - m_HeaderSize) / m_Stride);
 }
 
 PoolAllocator::~PoolAllocator() {
-    std::free(m_Memory);
+    for (Slab* list : { m_Available, m_Full }) {
+        while (list) {
+            Slab* next = list->next;
+            VirtualMemory::Unmap(list, m_SlabBytes);
+            list = next;
+        }
+    }
 }
 
 void* PoolAllocator::Allocate(usize size, usize alignment) {
-    (void)alignment; // Pool allocator uses fixed size
-    if (size > m_ObjectSize || !m_FreeList) {
+    if (size > m_ObjectSize || alignment > m_Alignment) {
         return nullptr;
     }
-    
-    FreeBlock* block = m_FreeList;
-    m_FreeList = m_FreeList->next;
-    return block;
+
+    Slab* slab = m_Available;
+    if (!slab) {
+        slab = CreateSlab();
+        if (!slab) {
+            return nullptr;
+        }
+    }
+
+    void* ptr;
+    if (slab->freeList) {
+        ptr = slab->freeList;
+        slab->freeList = slab->freeList->next;
+    } else {
+        ptr = GetSlabObjects(slab) + static_cast<usize>(slab->carved) * m_Stride;
+        ++slab->carved;
+    }
+
+    ++slab->liveCount;
+    ++m_LiveCount;
+    if (slab->liveCount == m_ObjectsPerSlab) {
+        UnlinkSlab(m_Available, slab);
+        LinkSlab(m_Full, slab);
+    }
+    return ptr;
 }
 
 void PoolAllocator::Deallocate(void* ptr) {
     if (!ptr) return;
-    
+
+    Slab* slab = reinterpret_cast<Slab*>(reinterpret_cast<usize>(ptr) & ~(m_SlabBytes - 1));
     FreeBlock* block = static_cast<FreeBlock*>(ptr);
-    block->next = m_FreeList;
-    m_FreeList = block;
+    block->next = slab->freeList;
+    slab->freeList = block;
+
+    if (slab->liveCount == m_ObjectsPerSlab) {
+        UnlinkSlab(m_Full, slab);
+        LinkSlab(m_Available, slab);
+    }
+    --slab->liveCount;
+    --m_LiveCount;
+
+    // Keep at least one slab so a single alloc/free pair cannot thrash the OS
+    if (slab->liveCount == 0 && m_ReleaseEmptySlabs && m_SlabCount > 1) {
+        UnlinkSlab(m_Available, slab);
+        DestroySlab(slab);
+    }
 }
 
 usize PoolAllocator::GetTotalAllocated() const {
-    usize allocated = 0;
-    FreeBlock* current = m_FreeList;
-    while (current) {
-        ++allocated;
-        current = current->next;
-    }
-    return (m_ObjectCount - allocated) * m_ObjectSize;
+    return m_LiveCount * m_Stride;
 }
 
 usize PoolAllocator::GetTotalCapacity() const {
-    return m_ObjectSize * m_ObjectCount;
+    return m_SlabCount * m_ObjectsPerSlab * m_Stride;
+}
+
+usize PoolAllocator::GetAllocationSize(const void* ptr) const {
+    return ptr ? m_ObjectSize : 0;
+}
+
+PoolAllocator::Slab* PoolAllocator::CreateSlab() {
+    if (m_MaxSlabs && m_SlabCount >= m_MaxSlabs) {
+        return nullptr;
+    }
+    Slab* slab = static_cast<Slab*>(VirtualMemory::Map(m_SlabBytes, m_SlabBytes));
+    if (!slab) {
+        return nullptr;
+    }
+    slab->freeList = nullptr;
+    slab->liveCount = 0;
+    slab->carved = 0;
+    LinkSlab(m_Available, slab);
+    ++m_SlabCount;
+    return slab;
+}
+
+void PoolAllocator::DestroySlab(Slab* slab) {
+    VirtualMemory::Unmap(slab, m_SlabBytes);
+    --m_SlabCount;
+}
+
+void PoolAllocator::LinkSlab(Slab*& list, Slab* slab) {
+    slab->prev = nullptr;
+    slab->next = list;
+    if (list) {
+        list->prev = slab;
+    }
+    list = slab;
+}
+
+void PoolAllocator::UnlinkSlab(Slab*& list, Slab* slab) {
+    if (slab->prev) {
+        slab->prev->next = slab->next;
+    } else {
+        list = slab->next;
+    }
+    if (slab->next) {
+        slab->next->prev = slab->prev;
+    }
 }
 
 // LinearAllocator implementation
@@ -183,22 +531,38 @@ LinearAllocator::LinearAllocator(usize size)
     : m_Size(size), m_Offset(0) {
     m_Memory = static_cast<u8*>(std::malloc(size));
     assert(m_Memory && "Failed to allocate memory for LinearAllocator");
+    m_Committed = size;
+}
+
+LinearAllocator::LinearAllocator(const VirtualArenaDesc& arena)
+    : m_Size(0), m_Offset(0), m_Arena(arena) {
+    m_Memory = ReserveArena(m_Arena, m_Size);
+    assert(m_Memory && "Failed to reserve address space for LinearAllocator");
 }
 
 LinearAllocator::~LinearAllocator() {
-    std::free(m_Memory);
+    if (m_Arena.reserveSize) {
+        VirtualMemory::Release(m_Memory, m_Size);
+    } else {
+        std::free(m_Memory);
+    }
+}
+
+bool LinearAllocator::EnsureCommitted(usize end) {
+    return !m_Arena.reserveSize || CommitArena(m_Memory, m_Arena, m_Committed, end);
 }
 
 void* LinearAllocator::Allocate(usize size, usize alignment) {
     usize offset = GetAlignmentOffset(m_Memory + m_Offset, alignment);
     usize totalSize = size + offset;
     
-    if (m_Offset + totalSize > m_Size) {
+    if (m_Offset + totalSize > m_Size || !EnsureCommitted(m_Offset + totalSize)) {
         return nullptr; // Out of memory
     }
     
-    void* ptr = m_Memory + m_Offset + offset;
+    u8* ptr = m_Memory + m_Offset + offset;
     m_Offset += totalSize;
+    m_LastAllocation = ptr;
     return ptr;
 }
 
@@ -216,8 +580,44 @@ usize LinearAllocator::GetTotalCapacity() const {
     return m_Size;
 }
 
+usize LinearAllocator::GetAllocationSize(const void* ptr) const {
+    if (ptr && ptr == m_LastAllocation) {
+        return static_cast<usize>(m_Memory + m_Offset - m_LastAllocation);
+    }
+    return 0;
+}
+
+void* LinearAllocator::Reallocate(void* ptr, usize newSize, usize alignment) {
+    if (!ptr) {
+        return Allocate(newSize, alignment);
+    }
+
+    u8* block = static_cast<u8*>(ptr);
+    if (block == m_LastAllocation && GetAlignmentOffset(block, alignment) == 0) {
+        // Nothing was allocated after this block, so it can grow into the free tail
+        usize end = static_cast<usize>(block - m_Memory) + newSize;
+        if (end > m_Size || !EnsureCommitted(end)) {
+            return nullptr;
+        }
+        m_Offset = end;
+        return block;
+    }
+
+    usize available = static_cast<usize>(m_Memory + m_Offset - block);
+    void* newPtr = Allocate(newSize, alignment);
+    if (!newPtr) {
+        return nullptr;
+    }
+    MemoryCopy(newPtr, block, available < newSize ? available : newSize);
+    return newPtr;
+}
+
 void LinearAllocator::Reset() {
     m_Offset = 0;
+    m_LastAllocation = nullptr;
+    if (m_Arena.reserveSize) {
+        ResetArena(m_Memory, m_Arena, m_Committed);
+    }
 }
 
 } // namespace Enjin
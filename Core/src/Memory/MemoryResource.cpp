@@ -0,0 +1,61 @@
+#include "Enjin/Memory/MemoryResource.h"
+#include <new>
+
+namespace Enjin {
+
+void* AllocatorResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    void* ptr = m_Allocator.Allocate(bytes, alignment);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void AllocatorResource::do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) {
+    (void)bytes;
+    (void)alignment;
+    m_Allocator.Deallocate(ptr);
+}
+
+bool AllocatorResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    if (this == &other) {
+        return true;
+    }
+    // Two bridges over the same allocator can free each other's memory
+    const auto* bridge = dynamic_cast<const AllocatorResource*>(&other);
+    return bridge && &bridge->m_Allocator == &m_Allocator;
+}
+
+namespace {
+
+class HeapResource final : public std::pmr::memory_resource {
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        void* ptr = Allocate(bytes, alignment);
+        if (!ptr) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+        (void)bytes;
+        (void)alignment;
+        Deallocate(ptr);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+} // namespace
+
+std::pmr::memory_resource* GetHeapResource() {
+    // Never destroyed: containers in static objects may free into it during exit
+    alignas(HeapResource) static u8 storage[sizeof(HeapResource)];
+    static HeapResource* resource = new (storage) HeapResource();
+    return resource;
+}
+
+} // namespace Enjin
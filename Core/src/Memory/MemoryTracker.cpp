@@ -0,0 +1,277 @@
+#include "Enjin/Memory/MemoryTracker.h"
+#include "Enjin/Logging/Log.h"
+#include "AtomicCounters.h"
+#include <atomic>
+#include <mutex>
+
+namespace Enjin {
+
+namespace {
+
+// Counters of one thread. Zero-initialized thread_local, so operator new can
+// use it before main() and without a TLS guard.
+struct ThreadMemoryCounters {
+    enum State : u8 { Uninitialized = 0, Active = 1, Dead = 2 };
+
+    std::atomic<i64> bytes[MEMORY_TAG_COUNT];
+    std::atomic<i64> count[MEMORY_TAG_COUNT];
+    std::atomic<i64> allocations[MEMORY_TAG_COUNT];
+    ThreadMemoryCounters* prev;
+    ThreadMemoryCounters* next;
+    u8 state;
+};
+
+// Totals of exited threads and of threads past TLS teardown
+struct SharedCounters {
+    std::atomic<i64> bytes[MEMORY_TAG_COUNT];
+    std::atomic<i64> count[MEMORY_TAG_COUNT];
+    std::atomic<i64> allocations[MEMORY_TAG_COUNT];
+};
+
+struct TrackerState {
+    std::mutex registryMutex;
+    ThreadMemoryCounters* threads = nullptr;
+    SharedCounters retired{};
+
+    // Owned by Update()/TakeSnapshot() under registryMutex
+    i64 peakBytes[MEMORY_TAG_COUNT] = {};
+    std::atomic<usize> budgets[MEMORY_TAG_COUNT] = {};
+    bool overBudget[MEMORY_TAG_COUNT] = {};
+};
+
+constinit TrackerState s_State;
+
+thread_local ThreadMemoryCounters t_Counters{};
+thread_local MemoryTag t_CurrentTag = MemoryTag::General;
+
+struct ThreadCountersReaper {
+    void Arm() {}
+    ~ThreadCountersReaper();
+};
+
+thread_local ThreadCountersReaper t_Reaper;
+
+const char* const s_TagNames[MEMORY_TAG_COUNT] = {
+    "General", "Renderer", "Physics", "ECS", "Asset", "Audio", "Log", "GUI", "World", "Script", "Editor"
+};
+
+ThreadMemoryCounters* GetThreadCounters() {
+    ThreadMemoryCounters* counters = &t_Counters;
+    if (counters->state == ThreadMemoryCounters::Active) [[likely]] {
+        return counters;
+    }
+    if (counters->state == ThreadMemoryCounters::Dead) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(s_State.registryMutex);
+    counters->prev = nullptr;
+    counters->next = s_State.threads;
+    if (s_State.threads) {
+        s_State.threads->prev = counters;
+    }
+    s_State.threads = counters;
+    counters->state = ThreadMemoryCounters::Active;
+    t_Reaper.Arm();
+    return counters;
+}
+
+ThreadCountersReaper::~ThreadCountersReaper() {
+    ThreadMemoryCounters* counters = &t_Counters;
+    if (counters->state != ThreadMemoryCounters::Active) {
+        counters->state = ThreadMemoryCounters::Dead;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(s_State.registryMutex);
+    for (usize i = 0; i < MEMORY_TAG_COUNT; ++i) {
+        s_State.retired.bytes[i].fetch_add(counters->bytes[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        s_State.retired.count[i].fetch_add(counters->count[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        s_State.retired.allocations[i].fetch_add(counters->allocations[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    if (counters->prev) {
+        counters->prev->next = counters->next;
+    } else {
+        s_State.threads = counters->next;
+    }
+    if (counters->next) {
+        counters->next->prev = counters->prev;
+    }
+    counters->state = ThreadMemoryCounters::Dead;
+}
+
+void Record(MemoryTag tag, i64 bytes, i64 count, i64 allocations) {
+    const usize index = static_cast<usize>(tag);
+    ThreadMemoryCounters* counters = GetThreadCounters();
+    if (counters) [[likely]] {
+        AddRelaxed(counters->bytes[index], bytes);
+        AddRelaxed(counters->count[index], count);
+        AddRelaxed(counters->allocations[index], allocations);
+        return;
+    }
+    s_State.retired.bytes[index].fetch_add(bytes, std::memory_order_relaxed);
+    s_State.retired.count[index].fetch_add(count, std::memory_order_relaxed);
+    s_State.retired.allocations[index].fetch_add(allocations, std::memory_order_relaxed);
+}
+
+// Sum every thread's counters; caller holds registryMutex
+MemorySnapshot CollectLocked() {
+    MemorySnapshot snapshot;
+    for (usize i = 0; i < MEMORY_TAG_COUNT; ++i) {
+        MemoryTagStats& stats = snapshot.tags[i];
+        stats.liveBytes = s_State.retired.bytes[i].load(std::memory_order_relaxed);
+        stats.liveCount = s_State.retired.count[i].load(std::memory_order_relaxed);
+        stats.totalAllocations = s_State.retired.allocations[i].load(std::memory_order_relaxed);
+    }
+    for (ThreadMemoryCounters* counters = s_State.threads; counters; counters = counters->next) {
+        for (usize i = 0; i < MEMORY_TAG_COUNT; ++i) {
+            MemoryTagStats& stats = snapshot.tags[i];
+            stats.liveBytes += counters->bytes[i].load(std::memory_order_relaxed);
+            stats.liveCount += counters->count[i].load(std::memory_order_relaxed);
+            stats.totalAllocations += counters->allocations[i].load(std::memory_order_relaxed);
+        }
+    }
+    for (usize i = 0; i < MEMORY_TAG_COUNT; ++i) {
+        MemoryTagStats& stats = snapshot.tags[i];
+        if (stats.liveBytes > s_State.peakBytes[i]) {
+            s_State.peakBytes[i] = stats.liveBytes;
+        }
+        stats.peakBytes = s_State.peakBytes[i];
+    }
+    return snapshot;
+}
+
+} // namespace
+
+const char* GetMemoryTagName(MemoryTag tag) {
+    const usize index = static_cast<usize>(tag);
+    return index < MEMORY_TAG_COUNT ? s_TagNames[index] : "Unknown";
+}
+
+MemorySnapshot MemorySnapshot::Diff(const MemorySnapshot& before, const MemorySnapshot& after) {
+    MemorySnapshot diff;
+    for (usize i = 0; i < MEMORY_TAG_COUNT; ++i) {
+        diff.tags[i].liveBytes = after.tags[i].liveBytes - before.tags[i].liveBytes;
+        diff.tags[i].liveCount = after.tags[i].liveCount - before.tags[i].liveCount;
+        diff.tags[i].totalAllocations = after.tags[i].totalAllocations - before.tags[i].totalAllocations;
+        diff.tags[i].peakBytes = after.tags[i].peakBytes;
+    }
+    return diff;
+}
+
+void MemoryTracker::RecordAllocation(MemoryTag tag, usize bytes) {
+    Record(tag, static_cast<i64>(bytes), 1, 1);
+}
+
+void MemoryTracker::RecordDeallocation(MemoryTag tag, usize bytes) {
+    Record(tag, -static_cast<i64>(bytes), -1, 0);
+}
+
+MemoryTag MemoryTracker::GetCurrentTag() {
+    return t_CurrentTag;
+}
+
+void MemoryTracker::SetCurrentTag(MemoryTag tag) {
+    t_CurrentTag = tag;
+}
+
+MemoryTagStats MemoryTracker::GetStats(MemoryTag tag) {
+    return TakeSnapshot()[tag];
+}
+
+MemorySnapshot MemoryTracker::TakeSnapshot() {
+    std::lock_guard<std::mutex> lock(s_State.registryMutex);
+    return CollectLocked();
+}
+
+void MemoryTracker::SetBudget(MemoryTag tag, usize bytes) {
+    s_State.budgets[static_cast<usize>(tag)].store(bytes, std::memory_order_relaxed);
+}
+
+usize MemoryTracker::GetBudget(MemoryTag tag) {
+    return s_State.budgets[static_cast<usize>(tag)].load(std::memory_order_relaxed);
+}
+
+void MemoryTracker::Update() {
+    MemorySnapshot snapshot;
+    bool crossed[MEMORY_TAG_COUNT] = {};
+    {
+        std::lock_guard<std::mutex> lock(s_State.registryMutex);
+        snapshot = CollectLocked();
+        for (usize i = 0; i < MEMORY_TAG_COUNT; ++i) {
+            const usize budget = s_State.budgets[i].load(std::memory_order_relaxed);
+            const bool over = budget > 0 && snapshot.tags[i].liveBytes > static_cast<i64>(budget);
+            crossed[i] = over && !s_State.overBudget[i];
+            s_State.overBudget[i] = over;
+        }
+    }
+
+    // Log outside the lock: logging allocates, and allocating registers threads
+    for (usize i = 0; i < MEMORY_TAG_COUNT; ++i) {
+        if (crossed[i]) {
+            ENJIN_LOG_WARN(Core, "Memory budget exceeded for %s: %.2f MB live, budget %.2f MB",
+                           s_TagNames[i], snapshot.tags[i].liveBytes / (1024.0 * 1024.0),
+                           s_State.budgets[i].load(std::memory_order_relaxed) / (1024.0 * 1024.0));
+        }
+    }
+}
+
+void MemoryTracker::LogSnapshot(const MemorySnapshot& snapshot) {
+    ENJIN_LOG_INFO(Core, "%-10s %14s %10s %14s %12s", "Tag", "Live bytes", "Blocks", "Peak bytes", "Allocs");
+    for (usize i = 0; i < MEMORY_TAG_COUNT; ++i) {
+        const MemoryTagStats& stats = snapshot.tags[i];
+        ENJIN_LOG_INFO(Core, "%-10s %14lld %10lld %14lld %12lld", s_TagNames[i],
+                       static_cast<long long>(stats.liveBytes), static_cast<long long>(stats.liveCount),
+                       static_cast<long long>(stats.peakBytes), static_cast<long long>(stats.totalAllocations));
+    }
+}
+
+void MemoryTracker::LogDiff(const MemorySnapshot& before, const MemorySnapshot& after) {
+    const MemorySnapshot diff = MemorySnapshot::Diff(before, after);
+    for (usize i = 0; i < MEMORY_TAG_COUNT; ++i) {
+        const MemoryTagStats& stats = diff.tags[i];
+        if (stats.liveBytes != 0 || stats.liveCount != 0) {
+            ENJIN_LOG_INFO(Core, "%-10s %+lld bytes in %+lld blocks (%lld allocations)", s_TagNames[i],
+                           static_cast<long long>(stats.liveBytes), static_cast<long long>(stats.liveCount),
+                           static_cast<long long>(stats.totalAllocations));
+        }
+    }
+}
+
+// ============================================================================
+// TrackedAllocator
+// ============================================================================
+
+TrackedAllocator::TrackedAllocator(IAllocator& inner, MemoryTag tag)
+    : m_Inner(inner), m_Tag(tag) {
+}
+
+void* TrackedAllocator::Allocate(usize size, usize alignment) {
+    void* ptr = m_Inner.Allocate(size, alignment);
+    if (ptr) {
+        Record(m_Tag, static_cast<i64>(m_Inner.GetAllocationSize(ptr)), 1, 1);
+    }
+    return ptr;
+}
+
+void TrackedAllocator::Deallocate(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    Record(m_Tag, -static_cast<i64>(m_Inner.GetAllocationSize(ptr)), -1, 0);
+    m_Inner.Deallocate(ptr);
+}
+
+void* TrackedAllocator::Reallocate(void* ptr, usize newSize, usize alignment) {
+    if (!ptr) {
+        return Allocate(newSize, alignment);
+    }
+    const usize oldSize = m_Inner.GetAllocationSize(ptr);
+    void* result = m_Inner.Reallocate(ptr, newSize, alignment);
+    if (result) {
+        Record(m_Tag, static_cast<i64>(m_Inner.GetAllocationSize(result)) - static_cast<i64>(oldSize), 0, 0);
+    }
+    return result;
+}
+
+} // namespace Enjin
@@ -0,0 +1,576 @@
+#include "Enjin/Memory/ThreadCachingAllocator.h"
+#include "Enjin/Memory/VirtualMemory.h"
+#include "AtomicCounters.h"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+
+namespace Enjin {
+
+namespace {
+
+constexpr usize RoundUp(usize value, usize alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Classes 0-7 step by 16 bytes up to 128; above that every power-of-two range
+// [2^k, 2^(k+1)] is split into four equal steps, up to 32 KB. Internal
+// fragmentation is bounded at 25% and every power of two is its own class.
+constexpr usize ComputeClassSize(u32 sizeClass) {
+    if (sizeClass < 8) {
+        return (sizeClass + 1) * 16;
+    }
+    u32 k = 7 + (sizeClass - 8) / 4;
+    u32 step = (sizeClass - 8) % 4 + 1;
+    return (usize(1) << k) + step * (usize(1) << (k - 2));
+}
+
+// Objects moved between a thread cache and the central list in one transfer
+constexpr u32 ComputeBatchSize(usize classSize) {
+    usize count = (32 * 1024) / classSize;
+    return static_cast<u32>(std::clamp<usize>(count, 2, 64));
+}
+
+// Bytes mapped per span when a central list runs out of objects
+constexpr usize ComputeSpanSize(usize classSize) {
+    return std::max(ThreadCachingAllocator::PAGE_SIZE,
+                    RoundUp(classSize * 8, ThreadCachingAllocator::PAGE_SIZE));
+}
+
+struct SizeClassTable {
+    usize classSize[ThreadCachingAllocator::NUM_SIZE_CLASSES] = {};
+    u32 batchSize[ThreadCachingAllocator::NUM_SIZE_CLASSES] = {};
+    usize spanSize[ThreadCachingAllocator::NUM_SIZE_CLASSES] = {};
+
+    constexpr SizeClassTable() {
+        for (u32 i = 0; i < ThreadCachingAllocator::NUM_SIZE_CLASSES; ++i) {
+            classSize[i] = ComputeClassSize(i);
+            batchSize[i] = ComputeBatchSize(classSize[i]);
+            spanSize[i] = ComputeSpanSize(classSize[i]);
+        }
+    }
+};
+
+constexpr SizeClassTable s_Classes;
+static_assert(ComputeClassSize(ThreadCachingAllocator::NUM_SIZE_CLASSES - 1) ==
+              ThreadCachingAllocator::MAX_SMALL_SIZE, "Size class table does not cover MAX_SMALL_SIZE");
+
+// Freed large spans up to this size are kept around for reuse instead of unmapped
+constexpr usize LARGE_CACHE_MAX_BYTES = 1024 * 1024;
+constexpr u32   LARGE_CACHE_SLOTS = 16;
+
+} // namespace
+
+struct ThreadCachingAllocator::Span {
+    u8* base;
+    usize bytes;
+    u16 sizeClass;
+    Span* nextRecord;
+};
+
+struct ThreadCachingAllocator::ThreadCache {
+    enum State : u8 { Uninitialized = 0, Active = 1, Dead = 2 };
+
+    struct Bin {
+        FreeObject* head;
+        u32 count;
+    };
+
+    Bin bins[NUM_SIZE_CLASSES];
+    std::atomic<i64> allocatedBytes; // Written only by the owning thread
+    ThreadCache* prev;
+    ThreadCache* next;
+    u8 state;
+};
+
+// Returns the owning thread's cache to the allocator when the thread exits
+struct ThreadCacheReaper {
+    void Arm() {}
+    ~ThreadCacheReaper();
+};
+
+// Zero-initialized, so no TLS guard is needed on the hot path
+static thread_local ThreadCachingAllocator::ThreadCache t_Cache{};
+static thread_local ThreadCacheReaper t_Reaper;
+
+ThreadCacheReaper::~ThreadCacheReaper() {
+    ThreadCachingAllocator::Get().ReleaseThreadCache(&t_Cache);
+}
+
+namespace {
+
+struct LargeSpanCache {
+    ThreadCachingAllocator::Span* spans[LARGE_CACHE_SLOTS] = {};
+    u32 count = 0;
+};
+
+// Guarded by m_PageMutex
+constinit LargeSpanCache s_LargeCache;
+
+} // namespace
+
+constinit ThreadCachingAllocator ThreadCachingAllocator::s_Instance;
+
+ThreadCachingAllocator& ThreadCachingAllocator::Get() {
+    return s_Instance;
+}
+
+u32 ThreadCachingAllocator::GetSizeClass(usize size) {
+    if (size <= 128) {
+        return size == 0 ? 0 : static_cast<u32>((size + 15) / 16 - 1);
+    }
+    u32 k = static_cast<u32>(std::bit_width(size - 1)) - 1;
+    usize step = ((size - 1) - (usize(1) << k)) >> (k - 2);
+    return 8 + (k - 7) * 4 + static_cast<u32>(step);
+}
+
+usize ThreadCachingAllocator::GetClassSize(u32 sizeClass) {
+    return s_Classes.classSize[sizeClass];
+}
+
+ThreadCachingAllocator::ThreadCache* ThreadCachingAllocator::GetThreadCache() {
+    ThreadCache* cache = &t_Cache;
+    if (cache->state == ThreadCache::Active) [[likely]] {
+        return cache;
+    }
+    if (cache->state == ThreadCache::Dead) {
+        return nullptr; // Thread is exiting; callers fall back to the central lists
+    }
+
+    cache->state = ThreadCache::Active;
+    t_Reaper.Arm();
+
+    std::lock_guard<std::mutex> lock(m_RegistryMutex);
+    cache->prev = nullptr;
+    cache->next = m_Caches;
+    if (m_Caches) {
+        m_Caches->prev = cache;
+    }
+    m_Caches = cache;
+    return cache;
+}
+
+void ThreadCachingAllocator::ReleaseThreadCache(ThreadCache* cache) {
+    if (cache->state != ThreadCache::Active) {
+        return;
+    }
+
+    for (u32 sizeClass = 0; sizeClass < NUM_SIZE_CLASSES; ++sizeClass) {
+        ThreadCache::Bin& bin = cache->bins[sizeClass];
+        while (bin.count > 0) {
+            ReleaseObjects(cache, sizeClass, std::min(bin.count, s_Classes.batchSize[sizeClass]));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_RegistryMutex);
+    if (cache->prev) {
+        cache->prev->next = cache->next;
+    } else {
+        m_Caches = cache->next;
+    }
+    if (cache->next) {
+        cache->next->prev = cache->prev;
+    }
+    m_RetiredBytes.fetch_add(cache->allocatedBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    cache->allocatedBytes.store(0, std::memory_order_relaxed);
+    cache->state = ThreadCache::Dead;
+}
+
+void ThreadCachingAllocator::FlushThreadCache() {
+    ThreadCache* cache = &t_Cache;
+    if (cache->state != ThreadCache::Active) {
+        return;
+    }
+    for (u32 sizeClass = 0; sizeClass < NUM_SIZE_CLASSES; ++sizeClass) {
+        ThreadCache::Bin& bin = cache->bins[sizeClass];
+        while (bin.count > 0) {
+            ReleaseObjects(cache, sizeClass, std::min(bin.count, s_Classes.batchSize[sizeClass]));
+        }
+    }
+}
+
+void* ThreadCachingAllocator::Allocate(usize size, usize alignment) {
+    if (alignment > DEFAULT_ALIGNMENT) {
+        // Power-of-two classes are naturally aligned inside 64 KB-aligned spans
+        usize rounded = std::bit_ceil(std::max(size, alignment));
+        if (alignment > PAGE_SIZE || rounded > MAX_SMALL_SIZE) {
+            return AllocateLarge(size, alignment);
+        }
+        size = rounded;
+    } else if (size > MAX_SMALL_SIZE) {
+        return AllocateLarge(size, alignment);
+    }
+
+    const u32 sizeClass = GetSizeClass(size);
+    const i64 classSize = static_cast<i64>(s_Classes.classSize[sizeClass]);
+
+    ThreadCache* cache = GetThreadCache();
+    if (cache) [[likely]] {
+        ThreadCache::Bin& bin = cache->bins[sizeClass];
+        FreeObject* object = bin.head;
+        if (!object) [[unlikely]] {
+            u32 count = 0;
+            object = FetchBatch(sizeClass, count);
+            if (!object) {
+                return nullptr;
+            }
+            bin.count = count;
+        }
+        bin.head = object->next;
+        --bin.count;
+        AddRelaxed(cache->allocatedBytes, classSize);
+        return object;
+    }
+
+    // No thread cache (thread teardown): take one object, hand the rest back
+    u32 count = 0;
+    FreeObject* object = FetchBatch(sizeClass, count);
+    if (!object) {
+        return nullptr;
+    }
+    if (count > 1) {
+        FreeObject* tail = object->next;
+        while (tail->next) {
+            tail = tail->next;
+        }
+        ReleaseToCentral(sizeClass, object->next, tail, count - 1);
+    }
+    m_RetiredBytes.fetch_add(classSize, std::memory_order_relaxed);
+    return object;
+}
+
+void ThreadCachingAllocator::Deallocate(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    Span* span = LookupSpan(ptr);
+    if (!span) {
+        // Not ours (e.g. memory from a C library or aligned operator new)
+        std::free(ptr);
+        return;
+    }
+    if (span->sizeClass == LARGE_SPAN) {
+        DeallocateLarge(span);
+        return;
+    }
+
+    const u32 sizeClass = span->sizeClass;
+    const i64 classSize = static_cast<i64>(s_Classes.classSize[sizeClass]);
+    FreeObject* object = static_cast<FreeObject*>(ptr);
+
+    ThreadCache* cache = GetThreadCache();
+    if (cache) [[likely]] {
+        ThreadCache::Bin& bin = cache->bins[sizeClass];
+        object->next = bin.head;
+        bin.head = object;
+        ++bin.count;
+        AddRelaxed(cache->allocatedBytes, -classSize);
+
+        const u32 batch = s_Classes.batchSize[sizeClass];
+        if (bin.count > batch * 2) [[unlikely]] {
+            ReleaseObjects(cache, sizeClass, batch);
+        }
+        return;
+    }
+
+    object->next = nullptr;
+    ReleaseToCentral(sizeClass, object, object, 1);
+    m_RetiredBytes.fetch_sub(classSize, std::memory_order_relaxed);
+}
+
+usize ThreadCachingAllocator::GetTotalAllocated() const {
+    i64 total = m_RetiredBytes.load(std::memory_order_relaxed) + m_LargeBytes.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(m_RegistryMutex);
+        for (ThreadCache* cache = m_Caches; cache; cache = cache->next) {
+            total += cache->allocatedBytes.load(std::memory_order_relaxed);
+        }
+    }
+    return total > 0 ? static_cast<usize>(total) : 0;
+}
+
+usize ThreadCachingAllocator::GetTotalCapacity() const {
+    return m_MappedBytes.load(std::memory_order_relaxed);
+}
+
+usize ThreadCachingAllocator::GetAllocationSize(const void* ptr) const {
+    Span* span = ptr ? LookupSpan(ptr) : nullptr;
+    if (!span) {
+        return 0;
+    }
+    if (span->sizeClass == LARGE_SPAN) {
+        return span->bytes - static_cast<usize>(static_cast<const u8*>(ptr) - span->base);
+    }
+    return s_Classes.classSize[span->sizeClass];
+}
+
+void* ThreadCachingAllocator::Reallocate(void* ptr, usize newSize, usize alignment) {
+    if (!ptr) {
+        return Allocate(newSize, alignment);
+    }
+
+    Span* span = LookupSpan(ptr);
+    if (!span) {
+        // Foreign block from the C heap
+        return alignment <= DEFAULT_ALIGNMENT ? std::realloc(ptr, newSize) : nullptr;
+    }
+
+    const bool aligned = (reinterpret_cast<usize>(ptr) & (alignment - 1)) == 0;
+    usize oldSize = 0;
+    if (span->sizeClass != LARGE_SPAN) {
+        oldSize = s_Classes.classSize[span->sizeClass];
+        // Keep the block unless it would waste more than half of it
+        if (aligned && newSize <= oldSize && (newSize > oldSize / 2 || oldSize <= 128)) {
+            return ptr;
+        }
+    } else {
+        oldSize = span->bytes;
+        if (aligned && newSize > MAX_SMALL_SIZE) {
+            if (void* resized = ResizeLarge(span, newSize, alignment)) {
+                return resized;
+            }
+        }
+    }
+
+    void* newPtr = Allocate(newSize, alignment);
+    if (!newPtr) {
+        return nullptr;
+    }
+    std::memcpy(newPtr, ptr, oldSize < newSize ? oldSize : newSize);
+    Deallocate(ptr);
+    return newPtr;
+}
+
+bool ThreadCachingAllocator::Owns(const void* ptr) const {
+    return ptr && LookupSpan(ptr) != nullptr;
+}
+
+ThreadCachingAllocator::FreeObject* ThreadCachingAllocator::FetchBatch(u32 sizeClass, u32& outCount) {
+    CentralList& central = m_Central[sizeClass];
+    const u32 batch = s_Classes.batchSize[sizeClass];
+    const usize classSize = s_Classes.classSize[sizeClass];
+
+    std::lock_guard<std::mutex> lock(central.mutex);
+
+    // Fast path: a full batch released earlier by some thread
+    if (central.batchCount > 0) {
+        outCount = batch;
+        return central.batches[--central.batchCount];
+    }
+
+    if (central.loose) {
+        FreeObject* head = central.loose;
+        FreeObject* tail = head;
+        u32 count = 1;
+        while (count < batch && tail->next) {
+            tail = tail->next;
+            ++count;
+        }
+        central.loose = tail->next;
+        central.looseCount -= count;
+        tail->next = nullptr;
+        outCount = count;
+        return head;
+    }
+
+    if (static_cast<usize>(central.carveEnd - central.carveCursor) < classSize) {
+        Span* span = CreateSpan(s_Classes.spanSize[sizeClass], PAGE_SIZE, static_cast<u16>(sizeClass));
+        if (!span) {
+            outCount = 0;
+            return nullptr;
+        }
+        central.carveCursor = span->base;
+        central.carveEnd = span->base + span->bytes;
+    }
+
+    // Carve lazily so untouched span pages never get faulted in
+    u32 count = static_cast<u32>(std::min<usize>(batch, (central.carveEnd - central.carveCursor) / classSize));
+    FreeObject* head = reinterpret_cast<FreeObject*>(central.carveCursor);
+    u8* cursor = central.carveCursor;
+    for (u32 i = 0; i < count - 1; ++i) {
+        reinterpret_cast<FreeObject*>(cursor)->next = reinterpret_cast<FreeObject*>(cursor + classSize);
+        cursor += classSize;
+    }
+    reinterpret_cast<FreeObject*>(cursor)->next = nullptr;
+    central.carveCursor = cursor + classSize;
+
+    outCount = count;
+    return head;
+}
+
+void ThreadCachingAllocator::ReleaseToCentral(u32 sizeClass, FreeObject* head, FreeObject* tail, u32 count) {
+    CentralList& central = m_Central[sizeClass];
+    std::lock_guard<std::mutex> lock(central.mutex);
+
+    if (count == s_Classes.batchSize[sizeClass] && central.batchCount < MAX_TRANSFER_BATCHES) {
+        tail->next = nullptr;
+        central.batches[central.batchCount++] = head;
+        return;
+    }
+
+    tail->next = central.loose;
+    central.loose = head;
+    central.looseCount += count;
+}
+
+void ThreadCachingAllocator::ReleaseObjects(ThreadCache* cache, u32 sizeClass, u32 count) {
+    ThreadCache::Bin& bin = cache->bins[sizeClass];
+    FreeObject* head = bin.head;
+    FreeObject* tail = head;
+    for (u32 i = 1; i < count; ++i) {
+        tail = tail->next;
+    }
+    bin.head = tail->next;
+    bin.count -= count;
+    ReleaseToCentral(sizeClass, head, tail, count);
+}
+
+void* ThreadCachingAllocator::AllocateLarge(usize size, usize alignment) {
+    const usize bytes = RoundUp(std::max<usize>(size, 1), PAGE_SIZE);
+
+    Span* span = nullptr;
+    if (bytes <= LARGE_CACHE_MAX_BYTES) {
+        std::lock_guard<std::mutex> lock(m_PageMutex);
+        for (u32 i = 0; i < s_LargeCache.count; ++i) {
+            Span* candidate = s_LargeCache.spans[i];
+            if (candidate->bytes == bytes && (reinterpret_cast<usize>(candidate->base) & (alignment - 1)) == 0) {
+                span = candidate;
+                s_LargeCache.spans[i] = s_LargeCache.spans[--s_LargeCache.count];
+                break;
+            }
+        }
+    }
+    if (!span) {
+        span = CreateSpan(bytes, std::max(alignment, PAGE_SIZE), LARGE_SPAN);
+        if (!span) {
+            return nullptr;
+        }
+    }
+
+    m_LargeBytes.fetch_add(static_cast<i64>(span->bytes), std::memory_order_relaxed);
+    return span->base;
+}
+
+void ThreadCachingAllocator::DeallocateLarge(Span* span) {
+    m_LargeBytes.fetch_sub(static_cast<i64>(span->bytes), std::memory_order_relaxed);
+
+    if (span->bytes <= LARGE_CACHE_MAX_BYTES) {
+        std::lock_guard<std::mutex> lock(m_PageMutex);
+        if (s_LargeCache.count < LARGE_CACHE_SLOTS) {
+            s_LargeCache.spans[s_LargeCache.count++] = span;
+            return;
+        }
+    }
+    DestroySpan(span);
+}
+
+void* ThreadCachingAllocator::ResizeLarge(Span* span, usize newSize, usize alignment) {
+    const usize newBytes = RoundUp(newSize, PAGE_SIZE);
+    if (newBytes == span->bytes) {
+        return span->base;
+    }
+
+    // Remap under the page lock: the old range must leave the page map before
+    // another thread can map something new at the same address
+    std::lock_guard<std::mutex> lock(m_PageMutex);
+    void* base = VirtualMemory::Remap(span->base, span->bytes, newBytes, std::max(alignment, PAGE_SIZE));
+    if (!base) {
+        // No remap support: shrinking keeps the bigger mapping, growing falls back to a copy
+        return newBytes < span->bytes ? span->base : nullptr;
+    }
+
+    const i64 delta = static_cast<i64>(newBytes) - static_cast<i64>(span->bytes);
+    RegisterSpan(span, nullptr);
+    span->base = static_cast<u8*>(base);
+    span->bytes = newBytes;
+    RegisterSpan(span, span);
+
+    m_LargeBytes.fetch_add(delta, std::memory_order_relaxed);
+    m_MappedBytes.fetch_add(static_cast<usize>(delta), std::memory_order_relaxed);
+    return base;
+}
+
+ThreadCachingAllocator::Span* ThreadCachingAllocator::CreateSpan(usize bytes, usize alignment, u16 sizeClass) {
+    void* base = VirtualMemory::Map(bytes, alignment);
+    if (!base) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_PageMutex);
+    Span* span = NewSpanRecord();
+    if (!span) {
+        VirtualMemory::Unmap(base, bytes);
+        return nullptr;
+    }
+    span->base = static_cast<u8*>(base);
+    span->bytes = bytes;
+    span->sizeClass = sizeClass;
+    span->nextRecord = nullptr;
+    RegisterSpan(span, span);
+    m_MappedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    return span;
+}
+
+void ThreadCachingAllocator::DestroySpan(Span* span) {
+    u8* base = span->base;
+    usize bytes = span->bytes;
+    {
+        std::lock_guard<std::mutex> lock(m_PageMutex);
+        RegisterSpan(span, nullptr);
+        span->nextRecord = m_FreeSpanRecords;
+        m_FreeSpanRecords = span;
+    }
+    m_MappedBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    VirtualMemory::Unmap(base, bytes);
+}
+
+ThreadCachingAllocator::Span* ThreadCachingAllocator::NewSpanRecord() {
+    if (!m_FreeSpanRecords) {
+        // Span metadata lives outside the spans so objects can start at offset 0
+        constexpr usize chunkSize = PAGE_SIZE;
+        Span* records = static_cast<Span*>(VirtualMemory::Map(chunkSize));
+        if (!records) {
+            return nullptr;
+        }
+        const usize count = chunkSize / sizeof(Span);
+        for (usize i = 0; i < count; ++i) {
+            records[i].nextRecord = (i + 1 < count) ? &records[i + 1] : nullptr;
+        }
+        m_FreeSpanRecords = records;
+    }
+    Span* span = m_FreeSpanRecords;
+    m_FreeSpanRecords = span->nextRecord;
+    return span;
+}
+
+void ThreadCachingAllocator::RegisterSpan(Span* span, Span* value) {
+    const usize first = reinterpret_cast<usize>(span->base) >> PAGE_SHIFT;
+    const usize last = (reinterpret_cast<usize>(span->base) + span->bytes - 1) >> PAGE_SHIFT;
+    for (usize page = first; page <= last; ++page) {
+        const usize rootIndex = page >> LEAF_BITS;
+        PageMapLeaf* leaf = m_PageMap[rootIndex].load(std::memory_order_acquire);
+        if (!leaf) {
+            // Zero-filled pages are valid null atomics
+            leaf = static_cast<PageMapLeaf*>(VirtualMemory::Map(sizeof(PageMapLeaf)));
+            m_PageMap[rootIndex].store(leaf, std::memory_order_release);
+        }
+        leaf->spans[page & ((usize(1) << LEAF_BITS) - 1)].store(value, std::memory_order_release);
+    }
+}
+
+ThreadCachingAllocator::Span* ThreadCachingAllocator::LookupSpan(const void* ptr) const {
+    const usize page = reinterpret_cast<usize>(ptr) >> PAGE_SHIFT;
+    const usize rootIndex = page >> LEAF_BITS;
+    if (rootIndex >= (usize(1) << ROOT_BITS)) {
+        return nullptr;
+    }
+    PageMapLeaf* leaf = m_PageMap[rootIndex].load(std::memory_order_acquire);
+    if (!leaf) {
+        return nullptr;
+    }
+    return leaf->spans[page & ((usize(1) << LEAF_BITS) - 1)].load(std::memory_order_acquire);
+}
+
+} // namespace Enjin
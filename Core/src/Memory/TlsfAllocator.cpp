@@ -0,0 +1,310 @@
+#include "Enjin/Memory/TlsfAllocator.h"
+#include "Enjin/Memory/VirtualMemory.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace Enjin {
+
+namespace {
+
+u64 RoundUp(u64 value, u64 alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+u32 Log2(u64 value) {
+    return 63u - static_cast<u32>(std::countl_zero(value));
+}
+
+} // namespace
+
+// ============================================================================
+// TlsfRange
+// ============================================================================
+
+TlsfRange::TlsfRange(u64 size, u32 maxAllocations, u64 granularity)
+    : m_Size(size & ~(granularity - 1))
+    , m_Granularity(granularity)
+    , m_MaxAllocations(std::max(maxAllocations, 1u)) {
+    assert(granularity > 0 && (granularity & (granularity - 1)) == 0 && "Granularity must be a power of two");
+
+    for (auto& firstLevel : m_FreeHeads) {
+        std::fill(std::begin(firstLevel), std::end(firstLevel), NONE);
+    }
+
+    // Free blocks never outnumber used blocks by more than one (they always
+    // merge), so twice the allocation limit plus one record always suffices
+    const u32 blockCount = m_MaxAllocations * 2 + 1;
+    m_Blocks.resize(blockCount);
+    m_UnusedBlocks.reserve(blockCount);
+    for (u32 i = blockCount; i > 0; --i) {
+        m_UnusedBlocks.push_back(i - 1);
+    }
+
+    if (m_Size > 0) {
+        u32 index = AcquireBlock();
+        m_Blocks[index] = { 0, m_Size, NONE, NONE, NONE, NONE, false };
+        InsertFree(index);
+    }
+}
+
+void TlsfRange::MapInsert(u64 size, u32& fl, u32& sl) {
+    if (size < SL_COUNT) {
+        // First level 0 is linear so tiny sizes don't all share one list
+        fl = 0;
+        sl = static_cast<u32>(size);
+        return;
+    }
+    const u32 log = Log2(size);
+    sl = static_cast<u32>(size >> (log - SL_BITS)) ^ SL_COUNT;
+    fl = log - SL_BITS + 1;
+}
+
+void TlsfRange::MapSearch(u64 size, u32& fl, u32& sl) {
+    // Round up to the next list boundary so any block in the list found fits
+    if (size >= SL_COUNT) {
+        const u64 round = (1ull << (Log2(size) - SL_BITS)) - 1;
+        size = size + round < size ? ~0ull : size + round;
+    }
+    MapInsert(size, fl, sl);
+}
+
+u32 TlsfRange::FindFreeBlock(u64 size) const {
+    u32 fl, sl;
+    MapSearch(size, fl, sl);
+
+    u32 slMap = m_SecondLevelMap[fl] & (~0u << sl);
+    if (slMap == 0) {
+        const u64 flMap = fl + 1 < 64 ? m_FirstLevelMap & (~0ull << (fl + 1)) : 0;
+        if (flMap == 0) {
+            return NONE;
+        }
+        fl = static_cast<u32>(std::countr_zero(flMap));
+        slMap = m_SecondLevelMap[fl];
+    }
+    sl = static_cast<u32>(std::countr_zero(slMap));
+    return m_FreeHeads[fl][sl];
+}
+
+void TlsfRange::InsertFree(u32 index) {
+    Block& block = m_Blocks[index];
+    u32 fl, sl;
+    MapInsert(block.size, fl, sl);
+
+    const u32 head = m_FreeHeads[fl][sl];
+    block.prevFree = NONE;
+    block.nextFree = head;
+    if (head != NONE) {
+        m_Blocks[head].prevFree = index;
+    }
+    m_FreeHeads[fl][sl] = index;
+    m_FirstLevelMap |= 1ull << fl;
+    m_SecondLevelMap[fl] |= 1u << sl;
+}
+
+void TlsfRange::RemoveFree(u32 index) {
+    Block& block = m_Blocks[index];
+    u32 fl, sl;
+    MapInsert(block.size, fl, sl);
+
+    if (block.prevFree != NONE) {
+        m_Blocks[block.prevFree].nextFree = block.nextFree;
+    }
+    if (block.nextFree != NONE) {
+        m_Blocks[block.nextFree].prevFree = block.prevFree;
+    }
+    if (m_FreeHeads[fl][sl] == index) {
+        m_FreeHeads[fl][sl] = block.nextFree;
+        if (block.nextFree == NONE) {
+            m_SecondLevelMap[fl] &= ~(1u << sl);
+            if (m_SecondLevelMap[fl] == 0) {
+                m_FirstLevelMap &= ~(1ull << fl);
+            }
+        }
+    }
+}
+
+u32 TlsfRange::AcquireBlock() {
+    assert(!m_UnusedBlocks.empty() && "TlsfRange ran out of block records");
+    const u32 index = m_UnusedBlocks.back();
+    m_UnusedBlocks.pop_back();
+    return index;
+}
+
+void TlsfRange::ReleaseBlock(u32 index) {
+    m_UnusedBlocks.push_back(index);
+}
+
+u32 TlsfRange::SplitBlock(u32 index, u64 size) {
+    const u32 tail = AcquireBlock();
+    Block& block = m_Blocks[index];
+    m_Blocks[tail] = { block.offset + size, block.size - size, index, block.nextPhysical, NONE, NONE, false };
+    if (block.nextPhysical != NONE) {
+        m_Blocks[block.nextPhysical].prevPhysical = tail;
+    }
+    block.nextPhysical = tail;
+    block.size = size;
+    return tail;
+}
+
+TlsfAllocation TlsfRange::Allocate(u64 size, u64 alignment) {
+    assert((alignment & (alignment - 1)) == 0 && "Alignment must be a power of two");
+    if (m_AllocationCount >= m_MaxAllocations) {
+        return {};
+    }
+
+    alignment = std::max(alignment, m_Granularity);
+    size = RoundUp(std::max<u64>(size, 1), m_Granularity);
+
+    // Offsets are multiples of the granularity, so padding never exceeds this
+    const u64 padding = alignment - m_Granularity;
+    if (size + padding < size) {
+        return {};
+    }
+    u32 index = FindFreeBlock(size + padding);
+    if (index == NONE) {
+        return {};
+    }
+    RemoveFree(index);
+
+    // Leave the unaligned head as a free block of its own
+    const u64 head = RoundUp(m_Blocks[index].offset, alignment) - m_Blocks[index].offset;
+    if (head > 0) {
+        const u32 aligned = SplitBlock(index, head);
+        InsertFree(index);
+        index = aligned;
+    }
+
+    // Neighbours of a free block are always used, so the tail needs no merge
+    if (m_Blocks[index].size > size) {
+        InsertFree(SplitBlock(index, size));
+    }
+
+    Block& block = m_Blocks[index];
+    block.used = true;
+    m_UsedSize += block.size;
+    ++m_AllocationCount;
+    return { block.offset, index };
+}
+
+void TlsfRange::Free(TlsfAllocation allocation) {
+    if (!allocation.IsValid()) {
+        return;
+    }
+    u32 index = allocation.metadata;
+    assert(index < m_Blocks.size() && m_Blocks[index].used && "Freeing a block that is not allocated");
+
+    Block& block = m_Blocks[index];
+    block.used = false;
+    m_UsedSize -= block.size;
+    --m_AllocationCount;
+
+    // Merge with the previous physical block
+    const u32 prev = block.prevPhysical;
+    if (prev != NONE && !m_Blocks[prev].used) {
+        RemoveFree(prev);
+        m_Blocks[prev].size += block.size;
+        m_Blocks[prev].nextPhysical = block.nextPhysical;
+        if (block.nextPhysical != NONE) {
+            m_Blocks[block.nextPhysical].prevPhysical = prev;
+        }
+        ReleaseBlock(index);
+        index = prev;
+    }
+
+    // Merge with the next physical block
+    Block& merged = m_Blocks[index];
+    const u32 next = merged.nextPhysical;
+    if (next != NONE && !m_Blocks[next].used) {
+        RemoveFree(next);
+        merged.size += m_Blocks[next].size;
+        merged.nextPhysical = m_Blocks[next].nextPhysical;
+        if (merged.nextPhysical != NONE) {
+            m_Blocks[merged.nextPhysical].prevPhysical = index;
+        }
+        ReleaseBlock(next);
+    }
+
+    InsertFree(index);
+}
+
+u64 TlsfRange::GetAllocationSize(TlsfAllocation allocation) const {
+    return allocation.IsValid() ? m_Blocks[allocation.metadata].size : 0;
+}
+
+u64 TlsfRange::GetLargestFreeBlock() const {
+    if (m_FirstLevelMap == 0) {
+        return 0;
+    }
+    const u32 fl = Log2(m_FirstLevelMap);
+    const u32 sl = 31u - static_cast<u32>(std::countl_zero(m_SecondLevelMap[fl]));
+
+    // Sizes within one list differ, so walk it (diagnostics only)
+    u64 largest = 0;
+    for (u32 index = m_FreeHeads[fl][sl]; index != NONE; index = m_Blocks[index].nextFree) {
+        largest = std::max(largest, m_Blocks[index].size);
+    }
+    return largest;
+}
+
+// ============================================================================
+// TlsfAllocator
+// ============================================================================
+
+TlsfAllocator::TlsfAllocator(usize size, u32 maxAllocations)
+    : m_Memory(static_cast<u8*>(VirtualMemory::Map(size)))
+    , m_Size(m_Memory ? size : 0)
+    , m_Range(m_Size, maxAllocations ? maxAllocations : static_cast<u32>(std::max<usize>(size / 256, 1)), DEFAULT_ALIGNMENT) {
+}
+
+TlsfAllocator::~TlsfAllocator() {
+    VirtualMemory::Unmap(m_Memory, m_Size);
+}
+
+void* TlsfAllocator::Allocate(usize size, usize alignment) {
+    alignment = std::max(alignment, DEFAULT_ALIGNMENT);
+    // The header sits right below the user pointer; a full alignment step keeps it aligned
+    const usize headerSize = std::max(sizeof(Header), alignment);
+
+    TlsfAllocation allocation = m_Range.Allocate(size + headerSize, alignment);
+    if (!allocation.IsValid()) {
+        return nullptr;
+    }
+
+    u8* ptr = m_Memory + allocation.offset + headerSize;
+    Header* header = reinterpret_cast<Header*>(ptr - sizeof(Header));
+    header->metadata = allocation.metadata;
+    header->headerSize = static_cast<u32>(headerSize);
+    return ptr;
+}
+
+void TlsfAllocator::Deallocate(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    const Header* header = GetHeader(ptr);
+    TlsfAllocation allocation;
+    allocation.offset = static_cast<u64>(static_cast<u8*>(ptr) - m_Memory) - header->headerSize;
+    allocation.metadata = header->metadata;
+    m_Range.Free(allocation);
+}
+
+usize TlsfAllocator::GetTotalAllocated() const {
+    return static_cast<usize>(m_Range.GetUsedSize());
+}
+
+usize TlsfAllocator::GetTotalCapacity() const {
+    return m_Size;
+}
+
+usize TlsfAllocator::GetAllocationSize(const void* ptr) const {
+    if (!ptr) {
+        return 0;
+    }
+    const Header* header = GetHeader(ptr);
+    TlsfAllocation allocation;
+    allocation.metadata = header->metadata;
+    return static_cast<usize>(m_Range.GetAllocationSize(allocation)) - header->headerSize;
+}
+
+} // namespace Enjin
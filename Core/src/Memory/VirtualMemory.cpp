@@ -0,0 +1,174 @@
+#include "Enjin/Memory/VirtualMemory.h"
+
+#if defined(ENJIN_PLATFORM_WINDOWS)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <Windows.h>
+#else
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace Enjin {
+namespace VirtualMemory {
+
+static usize RoundUp(usize value, usize alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+usize GetPageSize() {
+    static const usize pageSize = [] {
+#if defined(ENJIN_PLATFORM_WINDOWS)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return static_cast<usize>(info.dwPageSize);
+#else
+        return static_cast<usize>(sysconf(_SC_PAGESIZE));
+#endif
+    }();
+    return pageSize;
+}
+
+void* Reserve(usize size) {
+    size = RoundUp(size, GetPageSize());
+#if defined(ENJIN_PLATFORM_WINDOWS)
+    return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+    void* ptr = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+#endif
+}
+
+bool Commit(void* ptr, usize size) {
+#if defined(ENJIN_PLATFORM_WINDOWS)
+    return VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+    return mprotect(ptr, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+void Decommit(void* ptr, usize size) {
+#if defined(ENJIN_PLATFORM_WINDOWS)
+    VirtualFree(ptr, size, MEM_DECOMMIT);
+#else
+    // Drop the physical pages first, then make the range inaccessible again
+    madvise(ptr, size, MADV_DONTNEED);
+    mprotect(ptr, size, PROT_NONE);
+#endif
+}
+
+void Release(void* ptr, usize size) {
+    if (!ptr) {
+        return;
+    }
+#if defined(ENJIN_PLATFORM_WINDOWS)
+    (void)size;
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    munmap(ptr, RoundUp(size, GetPageSize()));
+#endif
+}
+
+void* Map(usize size, usize alignment) {
+    const usize pageSize = GetPageSize();
+    size = RoundUp(size, pageSize);
+    if (alignment < pageSize) {
+        alignment = pageSize;
+    }
+
+#if defined(ENJIN_PLATFORM_WINDOWS)
+    // VirtualAlloc already aligns to the 64 KB allocation granularity
+    void* ptr = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!ptr || (reinterpret_cast<usize>(ptr) & (alignment - 1)) == 0) {
+        return ptr;
+    }
+    VirtualFree(ptr, 0, MEM_RELEASE);
+
+    // Reserve an oversized range to find an aligned address, then re-map exactly there.
+    // Another thread can steal the address in between, so retry a few times.
+    for (int attempt = 0; attempt < 8; ++attempt) {
+        u8* probe = static_cast<u8*>(VirtualAlloc(nullptr, size + alignment, MEM_RESERVE, PAGE_NOACCESS));
+        if (!probe) {
+            return nullptr;
+        }
+        u8* aligned = reinterpret_cast<u8*>(RoundUp(reinterpret_cast<usize>(probe), alignment));
+        VirtualFree(probe, 0, MEM_RELEASE);
+        ptr = VirtualAlloc(aligned, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        if (ptr) {
+            return ptr;
+        }
+    }
+    return nullptr;
+#else
+    const int prot = PROT_READ | PROT_WRITE;
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    if (alignment == pageSize) {
+        void* ptr = mmap(nullptr, size, prot, flags, -1, 0);
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    }
+
+    // Over-map by the alignment and trim the unaligned head and tail
+    usize mappedSize = size + alignment;
+    void* raw = mmap(nullptr, mappedSize, prot, flags, -1, 0);
+    if (raw == MAP_FAILED) {
+        return nullptr;
+    }
+    u8* base = static_cast<u8*>(raw);
+    u8* aligned = reinterpret_cast<u8*>(RoundUp(reinterpret_cast<usize>(base), alignment));
+    usize head = static_cast<usize>(aligned - base);
+    usize tail = mappedSize - head - size;
+    if (head) {
+        munmap(base, head);
+    }
+    if (tail) {
+        munmap(aligned + size, tail);
+    }
+    return aligned;
+#endif
+}
+
+void Unmap(void* ptr, usize size) {
+    Release(ptr, size);
+}
+
+void* Remap(void* ptr, usize oldSize, usize newSize, usize alignment) {
+#if defined(ENJIN_PLATFORM_LINUX)
+    const usize pageSize = GetPageSize();
+    oldSize = RoundUp(oldSize, pageSize);
+    newSize = RoundUp(newSize, pageSize);
+
+    // In place: always works for shrinking, works for growth if the next pages are free
+    void* result = mremap(ptr, oldSize, newSize, 0);
+    if (result != MAP_FAILED) {
+        return result;
+    }
+
+    if (alignment <= pageSize) {
+        result = mremap(ptr, oldSize, newSize, MREMAP_MAYMOVE);
+        return result == MAP_FAILED ? nullptr : result;
+    }
+
+    // Carve an aligned destination, then let the kernel move the pages on top of it
+    void* destination = Map(newSize, alignment);
+    if (!destination) {
+        return nullptr;
+    }
+    result = mremap(ptr, oldSize, newSize, MREMAP_MAYMOVE | MREMAP_FIXED, destination);
+    if (result == MAP_FAILED) {
+        Unmap(destination, newSize);
+        return nullptr;
+    }
+    return result;
+#else
+    // No page-table remapping on this platform; callers fall back to copying
+    (void)ptr;
+    (void)oldSize;
+    (void)newSize;
+    (void)alignment;
+    return nullptr;
+#endif
+}
+
+} // namespace VirtualMemory
+} // namespace Enjin
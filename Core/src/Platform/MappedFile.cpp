@@ -0,0 +1,126 @@
+#include "Enjin/Platform/MappedFile.h"
+
+#if defined(ENJIN_PLATFORM_WINDOWS)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <utility>
+
+namespace Enjin::Platform {
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        m_Data = std::exchange(other.m_Data, nullptr);
+        m_Size = std::exchange(other.m_Size, 0);
+        m_Open = std::exchange(other.m_Open, false);
+#if defined(ENJIN_PLATFORM_WINDOWS)
+        m_File = std::exchange(other.m_File, nullptr);
+        m_Mapping = std::exchange(other.m_Mapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+
+#if defined(ENJIN_PLATFORM_WINDOWS)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+    m_File = file;
+    m_Size = static_cast<usize>(size.QuadPart);
+    m_Open = true;
+    if (m_Size == 0) {
+        return true; // Zero-length files can't be mapped
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        Close();
+        return false;
+    }
+    m_Mapping = mapping;
+    m_Data = static_cast<const u8*>(view);
+    return true;
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return false;
+    }
+    m_Size = static_cast<usize>(info.st_size);
+    m_Open = true;
+    if (m_Size == 0) {
+        close(fd);
+        return true; // Zero-length files can't be mapped
+    }
+
+    void* view = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps its own reference to the file
+    if (view == MAP_FAILED) {
+        m_Size = 0;
+        m_Open = false;
+        return false;
+    }
+    m_Data = static_cast<const u8*>(view);
+    return true;
+#endif
+}
+
+void MappedFile::Close() {
+#if defined(ENJIN_PLATFORM_WINDOWS)
+    if (m_Data) {
+        UnmapViewOfFile(m_Data);
+    }
+    if (m_Mapping) {
+        CloseHandle(m_Mapping);
+    }
+    if (m_File) {
+        CloseHandle(m_File);
+    }
+    m_File = nullptr;
+    m_Mapping = nullptr;
+#else
+    if (m_Data) {
+        munmap(const_cast<u8*>(m_Data), m_Size);
+    }
+#endif
+    m_Data = nullptr;
+    m_Size = 0;
+    m_Open = false;
+}
+
+} // namespace Enjin::Platform
@@ -0,0 +1,357 @@
+#include "Enjin/Threading/JobSystem.h"
+#include "Enjin/Logging/Log.h"
+#include "Enjin/Memory/Memory.h"
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file JobSystem.cpp
+ * @brief Chase-Lev work-stealing deques, injection queue and worker loop
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+
+namespace {
+
+constexpr u32 NO_THREAD = ~0u;
+
+struct Job {
+    JobFunction function = nullptr;
+    void* data = nullptr;
+    JobCounter* counter = nullptr;
+};
+
+/**
+ * Chase-Lev deque over a fixed ring ("Correct and Efficient Work-Stealing for
+ * Weak Memory Models", Le et al. 2013). The owner pushes and pops at the
+ * bottom; thieves take from the top. Slot fields are relaxed atomics so a
+ * thief racing the owner reads a stale job and then loses the CAS on top,
+ * rather than tearing it.
+ */
+class WorkDeque {
+public:
+    WorkDeque() : m_Slots(std::make_unique<Slot[]>(JobSystem::DEQUE_CAPACITY)) {}
+
+    // Owner only; false when full
+    bool Push(const Job& job) {
+        const i64 bottom = m_Bottom.load(std::memory_order_relaxed);
+        const i64 top = m_Top.load(std::memory_order_acquire);
+        if (bottom - top >= static_cast<i64>(JobSystem::DEQUE_CAPACITY)) {
+            return false;
+        }
+        Store(m_Slots[bottom & MASK], job);
+        m_Bottom.store(bottom + 1, std::memory_order_release); // Publishes the slot to thieves
+        return true;
+    }
+
+    // Owner only; takes the most recently pushed job
+    bool Pop(Job& job) {
+        const i64 bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+        m_Bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        i64 top = m_Top.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+        job = Load(m_Slots[bottom & MASK]);
+        if (top == bottom) {
+            // Last job: race the thieves for it
+            const bool won = m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Any thread; takes the oldest job
+    bool Steal(Job& job) {
+        i64 top = m_Top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const i64 bottom = m_Bottom.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return false;
+        }
+        job = Load(m_Slots[top & MASK]);
+        return m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr i64 MASK = JobSystem::DEQUE_CAPACITY - 1;
+    static_assert((JobSystem::DEQUE_CAPACITY & (JobSystem::DEQUE_CAPACITY - 1)) == 0, "Deque capacity must be a power of two");
+
+    struct Slot {
+        std::atomic<JobFunction> function{nullptr};
+        std::atomic<void*> data{nullptr};
+        std::atomic<JobCounter*> counter{nullptr};
+    };
+
+    static void Store(Slot& slot, const Job& job) {
+        slot.function.store(job.function, std::memory_order_relaxed);
+        slot.data.store(job.data, std::memory_order_relaxed);
+        slot.counter.store(job.counter, std::memory_order_relaxed);
+    }
+
+    static Job Load(const Slot& slot) {
+        return { slot.function.load(std::memory_order_relaxed),
+                 slot.data.load(std::memory_order_relaxed),
+                 slot.counter.load(std::memory_order_relaxed) };
+    }
+
+    alignas(CACHE_LINE_SIZE) std::atomic<i64> m_Top{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<i64> m_Bottom{0};
+    std::unique_ptr<Slot[]> m_Slots;
+};
+
+struct Pool {
+    std::unique_ptr<WorkDeque[]> deques; // [0] = the thread that called Initialize, [1..] = workers
+    u32 dequeCount = 0;
+    std::vector<std::thread> workers;
+
+    // Jobs from threads without a deque
+    std::mutex injectionMutex;
+    std::deque<Job> injection;
+    std::atomic<usize> injectionSize{0};
+
+    // Bumped on every push; idle workers sleep until it changes
+    alignas(CACHE_LINE_SIZE) std::atomic<u32> epoch{0};
+    std::atomic<u32> sleepers{0};
+    std::atomic<bool> stopping{false};
+};
+
+Pool* s_Pool = nullptr;
+thread_local u32 t_ThreadIndex = NO_THREAD; // Deque owned by this thread
+thread_local u32 t_Random = 0;
+
+u32 NextRandom() {
+    u32 state = t_Random ? t_Random : static_cast<u32>(reinterpret_cast<uintptr_t>(&t_Random)) | 1u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    t_Random = state;
+    return state;
+}
+
+void Release(JobCounter& counter);
+
+void Execute(const Job& job) {
+    job.function(job.data);
+    if (job.counter) {
+        Release(*job.counter);
+    }
+}
+
+void Push(Pool& pool, const Job& job) {
+    if (t_ThreadIndex != NO_THREAD) {
+        if (!pool.deques[t_ThreadIndex].Push(job)) {
+            Execute(job); // Deque full: the producer is far ahead, so it does the work itself
+            return;
+        }
+    } else {
+        std::lock_guard<std::mutex> lock(pool.injectionMutex);
+        pool.injection.push_back(job);
+        pool.injectionSize.fetch_add(1, std::memory_order_release);
+    }
+    pool.epoch.fetch_add(1, std::memory_order_seq_cst);
+    if (pool.sleepers.load(std::memory_order_seq_cst) > 0) {
+        pool.epoch.notify_one();
+    }
+}
+
+bool TakeInjected(Pool& pool, Job& job) {
+    if (pool.injectionSize.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(pool.injectionMutex);
+    if (pool.injection.empty()) {
+        return false;
+    }
+    job = pool.injection.front();
+    pool.injection.pop_front();
+    pool.injectionSize.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+// Own deque first (hot in cache), then the shared queue, then a random victim
+bool FindJob(Pool& pool, Job& job) {
+    const u32 self = t_ThreadIndex;
+    if (self != NO_THREAD && pool.deques[self].Pop(job)) {
+        return true;
+    }
+    if (TakeInjected(pool, job)) {
+        return true;
+    }
+    const u32 start = NextRandom() % pool.dequeCount;
+    for (u32 i = 0; i < pool.dequeCount; ++i) {
+        const u32 victim = (start + i) % pool.dequeCount;
+        if (victim != self && pool.deques[victim].Steal(job)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void QueueContinuations(JobContinuation* continuation) {
+    while (continuation) {
+        JobContinuation* next = continuation->next; // continuation may be reused once queued
+        const Job job{ continuation->function, continuation->data, continuation->counter };
+        if (s_Pool) {
+            Push(*s_Pool, job);
+        } else {
+            Execute(job);
+        }
+        continuation = next;
+    }
+}
+
+// Drop one reference. The thread that drops the last one takes the counter
+// to FINISHING rather than zero, so waiters can't return (and destroy the
+// counter) yet; it then detaches and queues the continuations, and only its
+// final compare-exchange releases the counter. A reference taken meanwhile
+// (see RunAfter) links its continuation before it is released, so a thread
+// releasing one while FINISHING is set queues the list itself before it
+// decrements; the finisher can then go to zero without looking again.
+void Release(JobCounter& counter) {
+    u32 value = counter.pending.load(std::memory_order_acquire);
+    bool drained = false;
+    for (;;) {
+        if (value == 1) {
+            if (counter.pending.compare_exchange_weak(value, JobCounter::FINISHING, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                break;
+            }
+            continue;
+        }
+        if ((value & JobCounter::FINISHING) && !drained) {
+            QueueContinuations(counter.continuations.exchange(nullptr, std::memory_order_acq_rel));
+            drained = true;
+        }
+        if (counter.pending.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return;
+        }
+    }
+
+    for (;;) {
+        QueueContinuations(counter.continuations.exchange(nullptr, std::memory_order_acq_rel));
+        u32 expected = JobCounter::FINISHING;
+        if (counter.pending.compare_exchange_strong(expected, 0, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return; // Done; counter may be destroyed from here on
+        }
+        // References were taken while we were finishing; hand them back so
+        // the last of them finishes instead, or look again if they are gone
+        if (expected != JobCounter::FINISHING &&
+            counter.pending.compare_exchange_strong(expected, expected - JobCounter::FINISHING, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return;
+        }
+    }
+}
+
+void WorkerMain(Pool& pool, u32 index) {
+    t_ThreadIndex = index;
+    for (;;) {
+        const u32 epoch = pool.epoch.load(std::memory_order_seq_cst);
+        Job job;
+        if (FindJob(pool, job)) {
+            Execute(job);
+            continue;
+        }
+        if (pool.stopping.load(std::memory_order_acquire)) {
+            return; // Stopping and drained
+        }
+        // A push after the epoch read changed it, so this returns at once
+        pool.sleepers.fetch_add(1, std::memory_order_seq_cst);
+        pool.epoch.wait(epoch, std::memory_order_seq_cst);
+        pool.sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace
+
+void JobSystem::Initialize(u32 workerCount) {
+    if (s_Pool) {
+        return;
+    }
+    if (workerCount == 0) {
+        const u32 hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    s_Pool = new Pool();
+    s_Pool->dequeCount = workerCount + 1;
+    s_Pool->deques = std::make_unique<WorkDeque[]>(s_Pool->dequeCount);
+    t_ThreadIndex = 0;
+    s_Pool->workers.reserve(workerCount);
+    for (u32 i = 0; i < workerCount; ++i) {
+        s_Pool->workers.emplace_back(WorkerMain, std::ref(*s_Pool), i + 1);
+    }
+    ENJIN_LOG_INFO(Core, "Job system started with %u workers", workerCount);
+}
+
+void JobSystem::Shutdown() {
+    if (!s_Pool) {
+        return;
+    }
+    s_Pool->stopping.store(true, std::memory_order_release);
+    s_Pool->epoch.fetch_add(1, std::memory_order_seq_cst);
+    s_Pool->epoch.notify_all();
+    for (std::thread& worker : s_Pool->workers) {
+        worker.join();
+    }
+    // Workers only exit once nothing is left to steal, so deque 0 is empty too
+    delete s_Pool;
+    s_Pool = nullptr;
+    t_ThreadIndex = NO_THREAD;
+}
+
+bool JobSystem::IsInitialized() {
+    return s_Pool != nullptr;
+}
+
+u32 JobSystem::GetWorkerCount() {
+    return s_Pool ? static_cast<u32>(s_Pool->workers.size()) : 0;
+}
+
+void JobSystem::Run(JobFunction function, void* data, JobCounter* counter) {
+    if (counter) {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    const Job job{ function, data, counter };
+    if (!s_Pool) {
+        Execute(job);
+        return;
+    }
+    Push(*s_Pool, job);
+}
+
+void JobSystem::RunAfter(JobCounter& dependency, JobContinuation& continuation) {
+    if (continuation.counter) {
+        continuation.counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Hold a reference while linking so dependency can't reach zero halfway;
+    // releasing it queues the list if the dependency already finished
+    dependency.pending.fetch_add(1, std::memory_order_acq_rel);
+    JobContinuation* head = dependency.continuations.load(std::memory_order_relaxed);
+    do {
+        continuation.next = head;
+    } while (!dependency.continuations.compare_exchange_weak(head, &continuation, std::memory_order_release, std::memory_order_relaxed));
+    Release(dependency);
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+    while (!counter.IsDone()) {
+        Job job;
+        if (s_Pool && FindJob(*s_Pool, job)) {
+            Execute(job);
+        } else {
+            std::this_thread::yield(); // Remaining jobs are running on other threads
+        }
+    }
+}
+
+} // namespace Enjin
@@ -0,0 +1,260 @@
+#pragma once
+
+#include "Enjin/Platform/Platform.h"
+#include "Enjin/ECS/Entity.h"
+#include "Enjin/ECS/Component.h"
+#include "Enjin/Memory/MemoryResource.h"
+#include <span>
+#include <utility>
+
+/**
+ * @file Archetype.h
+ * @brief Chunked structure-of-arrays storage grouping entities by component set
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+namespace ECS {
+
+// Size of one archetype chunk. Rows are packed so every column of a chunk
+// shares this block, which keeps a multi-component row within a few pages.
+constexpr usize ARCHETYPE_CHUNK_SIZE = 16 * 1024;
+
+/**
+ * @brief All entities that have exactly one set of component types
+ *
+ * Rows live in fixed-size chunks; each chunk holds an Entity column followed
+ * by one contiguous column per component type, then an added and a changed
+ * ChangeTick array per column. Every chunk but the last is full (removal
+ * moves the archetype's last row into the hole), so row r is at chunk
+ * r / capacity, slot r % capacity.
+ */
+class ENJIN_API Archetype {
+public:
+    struct Column {
+        const ComponentTypeInfo* info;
+        u32 offset;        // Byte offset of the column inside each chunk
+        u32 addedOffset;   // Byte offset of its added ticks
+        u32 changedOffset; // Byte offset of its changed ticks
+    };
+
+    // types must be sorted by id and free of duplicates
+    Archetype(std::span<const ComponentTypeInfo* const> types, std::pmr::memory_resource* resource);
+    ~Archetype();
+
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+
+    // Column index of a component type, -1 if this archetype lacks it
+    i32 GetColumnIndex(ComponentTypeId type) const {
+        return type < m_ColumnByType.size() ? m_ColumnByType[type] : -1;
+    }
+    bool Has(ComponentTypeId type) const { return GetColumnIndex(type) >= 0; }
+
+    const pmr::Vector<Column>& GetColumns() const { return m_Columns; }
+    usize GetEntityCount() const { return m_EntityCount; }
+    u32   GetChunkCapacity() const { return m_ChunkCapacity; }
+    usize GetChunkCount() const { return m_Chunks.size(); }
+
+    u32 GetChunkRowCount(usize chunk) const {
+        const usize begin = chunk * m_ChunkCapacity;
+        return static_cast<u32>(m_EntityCount - begin < m_ChunkCapacity ? m_EntityCount - begin : m_ChunkCapacity);
+    }
+
+    Entity* GetEntities(usize chunk) const { return reinterpret_cast<Entity*>(m_Chunks[chunk]); }
+    void*   GetColumnData(usize chunk, i32 column) const { return m_Chunks[chunk] + m_Columns[column].offset; }
+
+    ChangeTick* GetAddedTicks(usize chunk, i32 column) const {
+        return reinterpret_cast<ChangeTick*>(m_Chunks[chunk] + m_Columns[column].addedOffset);
+    }
+    ChangeTick* GetChangedTicks(usize chunk, i32 column) const {
+        return reinterpret_cast<ChangeTick*>(m_Chunks[chunk] + m_Columns[column].changedOffset);
+    }
+
+    Entity GetEntity(usize row) const { return GetEntities(row / m_ChunkCapacity)[row % m_ChunkCapacity]; }
+    void*  GetComponent(usize row, i32 column) const {
+        return m_Chunks[row / m_ChunkCapacity] + m_Columns[column].offset
+            + (row % m_ChunkCapacity) * m_Columns[column].info->size;
+    }
+
+    ChangeTick GetAddedTick(usize row, i32 column) const {
+        return GetAddedTicks(row / m_ChunkCapacity, column)[row % m_ChunkCapacity];
+    }
+    ChangeTick GetChangedTick(usize row, i32 column) const {
+        return GetChangedTicks(row / m_ChunkCapacity, column)[row % m_ChunkCapacity];
+    }
+    void SetChangedTick(usize row, i32 column, ChangeTick tick) {
+        GetChangedTicks(row / m_ChunkCapacity, column)[row % m_ChunkCapacity] = tick;
+    }
+
+private:
+    friend class ArchetypeStorage;
+
+    // Appends a row for entity; component slots are left uninitialized
+    usize PushRow(Entity entity);
+
+    // Fills a row whose components are already destroyed or moved out with
+    // the last row. Returns the entity now at row, or INVALID_ENTITY if row
+    // was the last one.
+    Entity RemoveRow(usize row);
+
+    void DestroyRow(usize row);
+
+    void SetTicks(usize row, i32 column, ChangeTick added, ChangeTick changed) {
+        GetAddedTicks(row / m_ChunkCapacity, column)[row % m_ChunkCapacity] = added;
+        SetChangedTick(row, column, changed);
+    }
+
+    std::pmr::memory_resource* m_Resource;
+    pmr::Vector<Column> m_Columns;
+    pmr::Vector<i32> m_ColumnByType;     // Indexed by ComponentTypeId
+    pmr::Vector<u8*> m_Chunks;
+    usize m_EntityCount = 0;
+    u32 m_ChunkCapacity = 0;
+    usize m_ChunkBytes = ARCHETYPE_CHUNK_SIZE;
+
+    // Cached transitions, indexed by the component type added or removed
+    pmr::Vector<Archetype*> m_AddEdges;
+    pmr::Vector<Archetype*> m_RemoveEdges;
+};
+
+struct EntityLocation {
+    Archetype* archetype = nullptr; // nullptr = entity has no components
+    usize row = 0;
+};
+
+/**
+ * @brief Archetype storage backend for World (StorageMode::Archetype)
+ *
+ * Adding or removing a component moves the entity's row to the archetype for
+ * its new component set; the transition is cached on the source archetype, so
+ * after warm-up a structural change is two array lookups plus the row copy.
+ * Iteration over several components is a linear walk over the columns of
+ * each matching chunk, with no per-entity lookups.
+ *
+ * Pointers to components are invalidated by any structural change.
+ */
+class ENJIN_API ArchetypeStorage {
+public:
+    explicit ArchetypeStorage(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    ~ArchetypeStorage();
+
+    ArchetypeStorage(const ArchetypeStorage&) = delete;
+    ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+
+    /**
+     * @brief Move the entity into an archetype that also has the given type
+     * @param tick Stamped as the new component's added and changed tick
+     * @return The uninitialized slot for the new component, which the caller
+     *         must construct before the next call; nullptr if already present
+     */
+    void* Add(Entity entity, const ComponentTypeInfo& info, ChangeTick tick = 0);
+
+    /**
+     * @brief Put entities without components straight into the archetype for types
+     * @param types Sorted by id and free of duplicates
+     * @param tick Stamped as every new component's added and changed tick
+     * @return The archetype, whose last entities.size() rows are the new
+     *         entities in order, with uninitialized components for the caller
+     *         to construct; nullptr if types is empty
+     */
+    Archetype* AddEntities(std::span<const Entity> entities, std::span<const ComponentTypeInfo* const> types, ChangeTick tick = 0);
+
+    void  Remove(Entity entity, ComponentTypeId type);
+    void* Get(Entity entity, ComponentTypeId type) const;
+
+    // Get() for writing: stamps the component as changed at tick
+    void* GetMutable(Entity entity, ComponentTypeId type, ChangeTick tick);
+    bool  Has(Entity entity, ComponentTypeId type) const { return Get(entity, type) != nullptr; }
+
+    void DestroyEntity(Entity entity);
+    void Clear();
+
+    Archetype* GetArchetype(Entity entity) const;
+
+    // nullptr for stale handles; archetype is nullptr for entities without components
+    const EntityLocation* GetLocation(Entity entity) const { return FindLocation(entity); }
+    const pmr::Vector<Archetype*>& GetArchetypes() const { return m_Archetypes; }
+
+    /**
+     * @brief Calls func(count, entities, Ts*...) once per chunk containing all
+     *        Ts and none of the excluded types
+     */
+    template<typename... Ts, typename Func>
+    void ForEachChunk(Func&& func, std::span<const ComponentTypeId> exclude = {}) const {
+        ForEachMatchingChunk<Ts...>([&func](const Archetype& archetype, usize chunk, const i32* columns) {
+            InvokeChunk<Ts...>(func, archetype, chunk, columns, std::index_sequence_for<Ts...>{});
+        }, exclude);
+    }
+
+    /**
+     * @brief Calls func(archetype, chunk, columns) once per non-empty chunk
+     *        containing all Ts and none of the excluded types
+     *
+     * columns[i] is the archetype's column index of the i-th of Ts, for
+     * callers that need more than the component data (e.g. change ticks).
+     */
+    template<typename... Ts, typename Func>
+    void ForEachMatchingChunk(Func&& func, std::span<const ComponentTypeId> exclude = {}) const {
+        static_assert(sizeof...(Ts) > 0, "Chunk iteration needs at least one component type");
+        const ComponentTypeId types[] = { ComponentRegistry::GetTypeId<std::remove_const_t<Ts>>()... };
+        for (Archetype* archetype : m_Archetypes) {
+            if (archetype->GetEntityCount() == 0) {
+                continue;
+            }
+            i32 columns[sizeof...(Ts)];
+            bool matches = true;
+            for (usize i = 0; i < sizeof...(Ts); ++i) {
+                columns[i] = archetype->GetColumnIndex(types[i]);
+                matches = matches && columns[i] >= 0;
+            }
+            for (ComponentTypeId excluded : exclude) {
+                matches = matches && !archetype->Has(excluded);
+            }
+            if (!matches) {
+                continue;
+            }
+            for (usize chunk = 0; chunk < archetype->GetChunkCount(); ++chunk) {
+                func(static_cast<const Archetype&>(*archetype), chunk, static_cast<const i32*>(columns));
+            }
+        }
+    }
+
+    /**
+     * @brief Calls func(entity, Ts&...) for every entity that has all Ts
+     */
+    template<typename... Ts, typename Func>
+    void Each(Func&& func) const {
+        ForEachChunk<Ts...>([&func](u32 count, const Entity* entities, Ts*... columns) {
+            for (u32 i = 0; i < count; ++i) {
+                func(entities[i], columns[i]...);
+            }
+        });
+    }
+
+private:
+    template<typename... Ts, typename Func, usize... I>
+    static void InvokeChunk(Func& func, const Archetype& archetype, usize chunk, const i32* columns, std::index_sequence<I...>) {
+        func(archetype.GetChunkRowCount(chunk), archetype.GetEntities(chunk),
+             static_cast<Ts*>(archetype.GetColumnData(chunk, columns[I]))...);
+    }
+
+    EntityLocation* FindLocation(Entity entity);
+    const EntityLocation* FindLocation(Entity entity) const;
+
+    Archetype* FindOrCreateArchetype(std::span<const ComponentTypeInfo* const> types);
+    Archetype* GetAddTarget(Archetype* from, const ComponentTypeInfo& info);
+    Archetype* GetRemoveTarget(Archetype* from, ComponentTypeId type);
+
+    // Relocates shared components into a new row of target, destroys the rest
+    void MoveEntity(Entity entity, EntityLocation& location, Archetype* target);
+    void RemoveRow(Archetype* archetype, usize row);
+
+    std::pmr::memory_resource* m_Resource;
+    pmr::Vector<EntityLocation> m_Locations; // Indexed by GetEntityIndex()
+    pmr::Vector<Archetype*> m_Archetypes;
+};
+
+} // namespace ECS
+} // namespace Enjin
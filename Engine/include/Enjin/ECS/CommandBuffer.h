@@ -0,0 +1,175 @@
+#pragma once
+
+#include "Enjin/Platform/Platform.h"
+#include "Enjin/ECS/World.h"
+#include "Enjin/Memory/MemoryResource.h"
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file CommandBuffer.h
+ * @brief Deferred structural changes: record during iteration, apply at a sync point
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+namespace ECS {
+
+/**
+ * @brief Records entity creation/destruction and component add/remove for later
+ *
+ * Recording never touches the World, so it is safe inside Each(),
+ * ParallelEach() and systems running concurrently (each thread records into
+ * its own buffer, see World::GetCommandBuffer). Playback applies everything
+ * in one pass: new entities are created first, component commands are
+ * sorted by type and entity so each storage is visited once, then entities
+ * are destroyed. Per entity and component type, commands keep the order in
+ * which they were recorded.
+ *
+ * CreateEntity() returns a placeholder that is only meaningful to the buffer
+ * that issued it; it becomes a real entity at playback (see Resolve()).
+ * Commands on entities that are dead by playback time are dropped.
+ *
+ * @threadsafe No; use one buffer per thread
+ *
+ * @example
+ * world.View<const Health>().ParallelEach([&world](Entity entity, const Health& health) {
+ *     if (health.value <= 0.0f) {
+ *         world.GetCommandBuffer().DestroyEntity(entity);
+ *     }
+ * });
+ * world.FlushCommandBuffers(); // Or let World::Update do it after the systems ran
+ */
+class ENJIN_API CommandBuffer {
+public:
+    explicit CommandBuffer(World& world);
+    CommandBuffer(World& world, std::pmr::memory_resource* resource);
+    ~CommandBuffer();
+
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+    /**
+     * @brief Reserve an entity that is created at playback
+     * @return Placeholder usable with this buffer's Add/Remove/DestroyEntity
+     */
+    Entity CreateEntity();
+
+    void DestroyEntity(Entity entity);
+
+    template<typename T>
+    void AddComponent(Entity entity, T component = T{}) {
+        static_assert(std::is_move_constructible_v<T>, "Components must be move constructible");
+        void* payload = m_Payloads.allocate(sizeof(T), alignof(T));
+        new (payload) T(std::move(component));
+        Record({ entity, ComponentRegistry::GetTypeId<T>(), CommandType::Add, payload, &ApplyComponentCommands<T>, &DestroyPayload<T> });
+    }
+
+    template<typename T>
+    void RemoveComponent(Entity entity) {
+        Record({ entity, ComponentRegistry::GetTypeId<T>(), CommandType::Remove, nullptr, &ApplyComponentCommands<T>, nullptr });
+    }
+
+    // Apply every recorded command to the world, then clear the buffer
+    void Playback();
+
+    /**
+     * @brief Apply several buffers in one sorted pass
+     *
+     * Used by World::FlushCommandBuffers; buffers must belong to world.
+     */
+    static void Playback(World& world, std::span<CommandBuffer* const> buffers);
+
+    // Discard the recorded commands without applying them
+    void Clear();
+
+    bool  Empty() const { return m_Commands.empty() && m_PendingCreates == 0; }
+    usize GetCommandCount() const { return m_Commands.size() + m_PendingCreates; }
+
+    /**
+     * @brief Entity created at the last playback for a placeholder
+     * @return entity itself if it is not a placeholder of this buffer
+     */
+    Entity Resolve(Entity entity) const;
+
+    // Placeholders use generation 0, which real entities never have
+    static bool IsPlaceholder(Entity entity) {
+        return GetEntityGeneration(entity) == 0 && entity != INVALID_ENTITY;
+    }
+
+private:
+    enum class CommandType : u8 { Add, Remove, Destroy };
+
+    struct Command;
+    using ApplyFunction = void (*)(World& world, std::span<const Command> commands);
+    using DestroyFunction = void (*)(void* payload);
+
+    struct Command {
+        Entity entity;
+        ComponentTypeId type;
+        CommandType kind;
+        void* payload;                  // Component to move in (Add only)
+        ApplyFunction apply;            // Applies a run of commands of this type
+        DestroyFunction destroyPayload; // Discards an unapplied payload
+    };
+
+    void Record(const Command& command) { m_Commands.push_back(command); }
+    void ResolveCreates();
+    void Reset();
+
+    // Every command has the same component type; they are sorted by entity
+    template<typename T>
+    static void ApplyComponentCommands(World& world, std::span<const Command> commands) {
+        MemoryTagScope memoryTag(MemoryTag::ECS);
+        ComponentStorage<T>* storage = world.m_StorageMode == StorageMode::SparseSet ? world.GetOrCreateStorage<T>() : nullptr;
+        const ChangeTick tick = world.GetChangeTick();
+
+        for (const Command& command : commands) {
+            T* payload = static_cast<T*>(command.payload);
+            if (!world.IsValid(command.entity)) {
+                if (payload) {
+                    payload->~T();
+                }
+                continue;
+            }
+
+            if (command.kind == CommandType::Add) {
+                if (storage) {
+                    if (T* existing = storage->GetMutable(command.entity, tick)) {
+                        *existing = std::move(*payload);
+                    } else {
+                        storage->Add(command.entity, tick) = std::move(*payload);
+                        world.OnComponentAdded(command.entity, ComponentRegistry::GetTypeId<T>());
+                    }
+                } else {
+                    world.AddComponent<T>(command.entity, std::move(*payload));
+                }
+                payload->~T();
+            } else if (storage) {
+                if (storage->Has(command.entity)) {
+                    world.OnComponentRemoving(command.entity, ComponentRegistry::GetTypeId<T>());
+                    storage->Remove(command.entity);
+                }
+            } else {
+                world.RemoveComponent<T>(command.entity);
+            }
+        }
+    }
+
+    template<typename T>
+    static void DestroyPayload(void* payload) {
+        static_cast<T*>(payload)->~T();
+    }
+
+    World& m_World;
+    pmr::Vector<Command> m_Commands;
+    pmr::Vector<Entity> m_Created;      // Placeholder index - 1 -> entity, from the last playback
+    u32 m_PendingCreates = 0;
+    std::pmr::monotonic_buffer_resource m_Payloads;
+};
+
+} // namespace ECS
+} // namespace Enjin
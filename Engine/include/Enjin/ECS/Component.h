@@ -2,9 +2,15 @@
 
 #include "Enjin/Platform/Platform.h"
 #include "Enjin/ECS/Entity.h"
-#include <typeindex>
-#include <unordered_map>
-#include <vector>
+#include "Enjin/Memory/MemoryResource.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <new>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 
 namespace Enjin {
 namespace ECS {
@@ -12,96 +18,517 @@ namespace ECS {
 // Component type ID
 using ComponentTypeId = u32;
 
-// Base component interface
+/**
+ * @brief World change tick stamped on components when they are added or written
+ *
+ * Ticks only grow (see World::GetChangeTick) and are compared with
+ * IsTickNewer, which stays correct across u32 wrap-around as long as the two
+ * ticks are less than 2^31 apart.
+ */
+using ChangeTick = u32;
+
+inline bool IsTickNewer(ChangeTick tick, ChangeTick since) {
+    return static_cast<i32>(tick - since) > 0;
+}
+
+// Base component interface. Deliberately not polymorphic (components are
+// never deleted through it), so components made of plain data stay trivially
+// copyable: memcpy'd when archetype rows move and storable in snapshots.
 struct ENJIN_API IComponent {
-    virtual ~IComponent() = default;
 };
 
-// Component registry - manages component type IDs
+// Type-erased layout and lifetime operations, for storages that keep
+// components of many types in raw memory (see Archetype.h)
+struct ComponentTypeInfo {
+    ComponentTypeId id = 0;
+    u32 size = 0;
+    u32 alignment = 0;
+    void (*relocate)(void* dst, void* src) = nullptr; // Move-construct dst from src, then destroy src; nullptr = memcpy
+    void (*destroy)(void* ptr) = nullptr;             // nullptr = trivially destructible
+};
+
+// Stable identity of a component type, for serialization (see ComponentRegistry)
+using ComponentTypeHash = u64;
+
+/**
+ * @brief Component type identities
+ *
+ * Every type has two identities:
+ * - GetTypeHash<T>(): an FNV-1a hash of the type's qualified name, computed
+ *   at compile time. It is the same in every translation unit and module
+ *   built by one compiler and across runs, so it is what gets written to disk.
+ * - GetTypeId<T>(): a small dense index for flat per-type tables (World's
+ *   storages, archetype columns). It is assigned on first use from one
+ *   process-wide table keyed by the hash, so every module agrees on it, but
+ *   it depends on registration order and must not be persisted.
+ *
+ * Types in an anonymous namespace are private to their translation unit, so
+ * each gets its own index even when two share a name (and thus a hash).
+ */
 class ENJIN_API ComponentRegistry {
 public:
     template<typename T>
     static ComponentTypeId GetTypeId() {
-        static ComponentTypeId id = s_NextComponentId++;
+        static const ComponentTypeId id = Register(GetTypeHash<T>(), GetTypeName<T>());
         return id;
     }
 
-    static ComponentTypeId GetNextId() { return s_NextComponentId; }
+    template<typename T>
+    static constexpr ComponentTypeHash GetTypeHash() {
+        return Hash(GetTypeName<T>());
+    }
+
+    // Qualified name as spelled by the compiler (e.g. "Enjin::ECS::TransformComponent")
+    template<typename T>
+    static constexpr std::string_view GetTypeName() {
+        constexpr std::string_view probe = RawName<double>();
+        constexpr usize prefix = probe.find("double");
+        constexpr usize suffix = probe.size() - prefix - std::string_view("double").size();
+        constexpr std::string_view raw = RawName<T>();
+        return raw.substr(prefix, raw.size() - prefix - suffix);
+    }
+
+    template<typename T>
+    static const ComponentTypeInfo& GetTypeInfo() {
+        static_assert(std::is_move_constructible_v<T>, "Components must be move constructible");
+        static const ComponentTypeInfo info = {
+            GetTypeId<T>(),
+            static_cast<u32>(sizeof(T)),
+            static_cast<u32>(alignof(T)),
+            std::is_trivially_copyable_v<T> ? nullptr : +[](void* dst, void* src) {
+                T* source = static_cast<T*>(src);
+                new (dst) T(std::move(*source));
+                source->~T();
+            },
+            std::is_trivially_destructible_v<T> ? nullptr : +[](void* ptr) {
+                static_cast<T*>(ptr)->~T();
+            }
+        };
+        return info;
+    }
+
+    // Id of the type registered under hash, 0 if none has been yet
+    static ComponentTypeId FindTypeId(ComponentTypeHash hash);
+
+    // Hash of a registered id, 0 if id is unknown
+    static ComponentTypeHash GetTypeHash(ComponentTypeId id);
+
+    // One past the largest id handed out so far
+    static ComponentTypeId GetNextId();
+
+private:
+    static ComponentTypeId Register(ComponentTypeHash hash, std::string_view name);
+
+    template<typename T>
+    static constexpr std::string_view RawName() {
+#if defined(_MSC_VER) && !defined(__clang__)
+        return __FUNCSIG__;
+#else
+        return __PRETTY_FUNCTION__;
+#endif
+    }
+
+    // 64-bit FNV-1a
+    static constexpr ComponentTypeHash Hash(std::string_view name) {
+        ComponentTypeHash hash = 0xcbf29ce484222325ull;
+        for (char c : name) {
+            hash ^= static_cast<u8>(c);
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+};
+
+// Component types a ComponentMask can hold; registering one more aborts, in every build
+constexpr usize MAX_COMPONENT_TYPES = 128;
+
+/**
+ * @brief A set of component types, one bit per ComponentTypeId
+ *
+ * World keeps one per entity (which storages hold its components) and
+ * systems declare one as their signature.
+ */
+class ComponentMask {
+public:
+    template<typename... Ts>
+    static ComponentMask Of() {
+        ComponentMask mask;
+        (mask.Set(ComponentRegistry::GetTypeId<std::remove_const_t<Ts>>()), ...);
+        return mask;
+    }
+
+    void Set(ComponentTypeId type) { m_Words[type / 64] |= Bit(type); }
+    void Reset(ComponentTypeId type) { m_Words[type / 64] &= ~Bit(type); }
+    bool Test(ComponentTypeId type) const { return (m_Words[type / 64] & Bit(type)) != 0; }
+
+    // Every type of other is also in this mask
+    bool ContainsAll(const ComponentMask& other) const {
+        for (usize i = 0; i < WORD_COUNT; ++i) {
+            if ((m_Words[i] & other.m_Words[i]) != other.m_Words[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // At least one type is in both masks
+    bool Intersects(const ComponentMask& other) const {
+        for (usize i = 0; i < WORD_COUNT; ++i) {
+            if (m_Words[i] & other.m_Words[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool Empty() const {
+        for (u64 word : m_Words) {
+            if (word) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Calls func(ComponentTypeId) for every type in the mask, in id order
+    template<typename Func>
+    void ForEach(Func&& func) const {
+        for (usize i = 0; i < WORD_COUNT; ++i) {
+            for (u64 word = m_Words[i]; word; word &= word - 1) {
+                func(static_cast<ComponentTypeId>(i * 64 + std::countr_zero(word)));
+            }
+        }
+    }
+
+    ComponentMask& operator|=(const ComponentMask& other) {
+        for (usize i = 0; i < WORD_COUNT; ++i) {
+            m_Words[i] |= other.m_Words[i];
+        }
+        return *this;
+    }
+
+    bool operator==(const ComponentMask& other) const = default;
 
 private:
-    static ComponentTypeId s_NextComponentId;
+    static constexpr usize WORD_COUNT = MAX_COMPONENT_TYPES / 64;
+
+    static u64 Bit(ComponentTypeId type) { return u64(1) << (type % 64); }
+
+    u64 m_Words[WORD_COUNT] = {};
 };
 
-// Component storage - Structure of Arrays (SoA) for cache efficiency
+// Entities per sparse page of a ComponentStorage. One page of u32 indices is
+// 16 KB; pages are only allocated for ID ranges that hold the component.
+constexpr usize SPARSE_PAGE_SIZE = 4096;
+
+// Component storage - paged sparse set with Structure of Arrays (SoA) dense
+// data for cache efficiency. The sparse array maps an entity index to its
+// dense index, so Add, Get, Has and Remove are plain array accesses; entities
+// and components stay packed for iteration. Lookups compare the full handle
+// stored in the dense array, so a stale handle never finds the component of
+// an entity that reused its index. Each component also carries the tick at
+// which it was added and last written, in arrays parallel to the dense data.
+// All memory comes from the given memory resource.
 template<typename T>
 class ComponentStorage {
 public:
-    T& Add(Entity entity) {
+    explicit ComponentStorage(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : m_Entities(resource), m_Components(resource), m_AddedTicks(resource), m_ChangedTicks(resource), m_Pages(resource) {
+    }
+
+    ~ComponentStorage() {
+        ReleasePages();
+    }
+
+    ComponentStorage(const ComponentStorage&) = delete;
+    ComponentStorage& operator=(const ComponentStorage&) = delete;
+
+    // Returns the existing component unchanged if the entity already has one
+    T& Add(Entity entity, ChangeTick tick = 0) {
+        u32& slot = AcquireSlot(entity);
+        if (slot != NONE) {
+            if (m_Entities[slot] != entity) {
+                // Left behind by an older generation of this index
+                m_Entities[slot] = entity;
+                m_Components[slot] = T{};
+                m_AddedTicks[slot] = tick;
+                m_ChangedTicks[slot] = tick;
+            }
+            return m_Components[slot];
+        }
+        slot = static_cast<u32>(m_Components.size());
         m_Entities.push_back(entity);
-        m_Components.push_back(T{});
-        m_EntityToIndex[entity] = m_Components.size() - 1;
+        m_Components.emplace_back();
+        m_AddedTicks.push_back(tick);
+        m_ChangedTicks.push_back(tick);
         return m_Components.back();
     }
 
+    /**
+     * @brief Add components[i] to entities[i]
+     *
+     * Entities that already have the component get it overwritten (and
+     * stamped changed). Runs of entities new to the storage are appended with
+     * one copy per array, a memcpy for trivially copyable T.
+     */
+    void Add(std::span<const Entity> entities, std::span<const T> components, ChangeTick tick = 0) {
+        AddRange(entities, tick,
+            [this, components](usize begin, usize count) { AppendRange(m_Components, components.data() + begin, count); },
+            [components](usize i) -> const T& { return components[i]; });
+    }
+
+    // Add() of the same component to every entity
+    void Add(std::span<const Entity> entities, const T& component, ChangeTick tick = 0) {
+        AddRange(entities, tick,
+            [this, &component](usize, usize count) { m_Components.insert(m_Components.end(), count, component); },
+            [&component](usize) -> const T& { return component; });
+    }
+
     void Remove(Entity entity) {
-        auto it = m_EntityToIndex.find(entity);
-        if (it == m_EntityToIndex.end()) {
+        u32* slot = FindSlot(entity);
+        if (!slot || *slot == NONE || m_Entities[*slot] != entity) {
             return;
         }
 
-        usize index = it->second;
-        usize lastIndex = m_Components.size() - 1;
+        const u32 index = *slot;
+        const u32 lastIndex = static_cast<u32>(m_Components.size() - 1);
 
         // Swap with last element
         if (index != lastIndex) {
             m_Components[index] = std::move(m_Components[lastIndex]);
             m_Entities[index] = m_Entities[lastIndex];
-            m_EntityToIndex[m_Entities[index]] = index;
+            m_AddedTicks[index] = m_AddedTicks[lastIndex];
+            m_ChangedTicks[index] = m_ChangedTicks[lastIndex];
+            *FindSlot(m_Entities[index]) = index;
         }
 
         m_Components.pop_back();
         m_Entities.pop_back();
-        m_EntityToIndex.erase(it);
+        m_AddedTicks.pop_back();
+        m_ChangedTicks.pop_back();
+        *slot = NONE;
     }
 
-    T* Get(Entity entity) {
-        auto it = m_EntityToIndex.find(entity);
-        if (it == m_EntityToIndex.end()) {
-            return nullptr;
+    // Remove() for many entities. Large batches clear their slots and then
+    // close the gaps in one linear pass instead of swapping each one out.
+    void Remove(std::span<const Entity> entities) {
+        if (entities.size() * 4 < m_Components.size()) {
+            for (Entity entity : entities) {
+                Remove(entity);
+            }
+            return;
+        }
+
+        usize removed = 0;
+        for (Entity entity : entities) {
+            u32* slot = FindSlot(entity);
+            if (slot && *slot != NONE && m_Entities[*slot] == entity) {
+                m_Entities[*slot] = INVALID_ENTITY;
+                *slot = NONE;
+                ++removed;
+            }
+        }
+        if (removed == 0) {
+            return;
+        }
+
+        usize write = 0;
+        for (usize read = 0; read < m_Entities.size(); ++read) {
+            if (m_Entities[read] == INVALID_ENTITY) {
+                continue;
+            }
+            if (write != read) {
+                m_Components[write] = std::move(m_Components[read]);
+                m_Entities[write] = m_Entities[read];
+                m_AddedTicks[write] = m_AddedTicks[read];
+                m_ChangedTicks[write] = m_ChangedTicks[read];
+                *FindSlot(m_Entities[write]) = static_cast<u32>(write);
+            }
+            ++write;
+        }
+        m_Components.erase(m_Components.begin() + write, m_Components.end());
+        m_Entities.resize(write);
+        m_AddedTicks.resize(write);
+        m_ChangedTicks.resize(write);
+    }
+
+    // Exchange two dense positions (entity, component and ticks); used to
+    // keep group members packed at the front
+    void Swap(u32 a, u32 b) {
+        if (a == b) {
+            return;
         }
-        return &m_Components[it->second];
+        using std::swap;
+        swap(m_Components[a], m_Components[b]);
+        swap(m_Entities[a], m_Entities[b]);
+        swap(m_AddedTicks[a], m_AddedTicks[b]);
+        swap(m_ChangedTicks[a], m_ChangedTicks[b]);
+        *FindSlot(m_Entities[a]) = a;
+        *FindSlot(m_Entities[b]) = b;
+    }
+
+    T* Get(Entity entity) {
+        const u32 index = GetIndex(entity);
+        return index != NONE ? &m_Components[index] : nullptr;
     }
 
     const T* Get(Entity entity) const {
-        auto it = m_EntityToIndex.find(entity);
-        if (it == m_EntityToIndex.end()) {
+        const u32 index = GetIndex(entity);
+        return index != NONE ? &m_Components[index] : nullptr;
+    }
+
+    // Get() for writing: stamps the component as changed at tick
+    T* GetMutable(Entity entity, ChangeTick tick) {
+        const u32 index = GetIndex(entity);
+        if (index == NONE) {
             return nullptr;
         }
-        return &m_Components[it->second];
+        m_ChangedTicks[index] = tick;
+        return &m_Components[index];
     }
 
     bool Has(Entity entity) const {
-        return m_EntityToIndex.find(entity) != m_EntityToIndex.end();
+        return GetIndex(entity) != NONE;
+    }
+
+    // Dense index of the entity's component, or NONE
+    u32 GetIndex(Entity entity) const {
+        const u32 index = GetEntityIndex(entity);
+        const usize page = index / SPARSE_PAGE_SIZE;
+        if (page >= m_Pages.size() || !m_Pages[page]) {
+            return NONE;
+        }
+        const u32 dense = m_Pages[page][index % SPARSE_PAGE_SIZE];
+        return dense != NONE && m_Entities[dense] == entity ? dense : NONE;
+    }
+
+    void Reserve(usize capacity) {
+        m_Entities.reserve(capacity);
+        m_Components.reserve(capacity);
+        m_AddedTicks.reserve(capacity);
+        m_ChangedTicks.reserve(capacity);
     }
 
     void Clear() {
         m_Components.clear();
         m_Entities.clear();
-        m_EntityToIndex.clear();
+        m_AddedTicks.clear();
+        m_ChangedTicks.clear();
+        ReleasePages();
+        m_Pages.clear();
     }
 
     usize Size() const { return m_Components.size(); }
     bool Empty() const { return m_Components.empty(); }
 
     // Iteration support
-    const std::vector<Entity>& GetEntities() const { return m_Entities; }
-    const std::vector<T>& GetComponents() const { return m_Components; }
-    std::vector<T>& GetComponents() { return m_Components; }
+    const pmr::Vector<Entity>& GetEntities() const { return m_Entities; }
+    const pmr::Vector<T>& GetComponents() const { return m_Components; }
+    pmr::Vector<T>& GetComponents() { return m_Components; }
+
+    // Parallel to GetComponents(); writers through GetComponents() stamp
+    // GetChangedTicks() themselves (World and views do)
+    const pmr::Vector<ChangeTick>& GetAddedTicks() const { return m_AddedTicks; }
+    const pmr::Vector<ChangeTick>& GetChangedTicks() const { return m_ChangedTicks; }
+    pmr::Vector<ChangeTick>& GetChangedTicks() { return m_ChangedTicks; }
+
+    static constexpr u32 NONE = ~0u;
 
 private:
-    std::vector<Entity> m_Entities;
-    std::vector<T> m_Components;
-    std::unordered_map<Entity, usize> m_EntityToIndex;
+    template<typename Append, typename Value>
+    void AddRange(std::span<const Entity> entities, ChangeTick tick, Append&& append, Value&& value) {
+        const usize required = m_Components.size() + entities.size();
+        if (required > m_Components.capacity()) {
+            Reserve(std::max(required, m_Components.capacity() * 2));
+        }
+
+        usize i = 0;
+        while (i < entities.size()) {
+            // Claim slots for a run of entities the storage hasn't seen...
+            const usize begin = i;
+            const u32 first = static_cast<u32>(m_Components.size());
+            for (; i < entities.size(); ++i) {
+                u32& slot = AcquireSlot(entities[i]);
+                if (slot != NONE) {
+                    break;
+                }
+                slot = first + static_cast<u32>(i - begin);
+            }
+            // ...then append the run in one go
+            if (i > begin) {
+                const usize count = i - begin;
+                AppendRange(m_Entities, entities.data() + begin, count);
+                append(begin, count);
+                m_AddedTicks.insert(m_AddedTicks.end(), count, tick);
+                m_ChangedTicks.insert(m_ChangedTicks.end(), count, tick);
+            }
+            // Already has one (possibly from earlier in this batch), or the
+            // slot was left behind by an older generation of the index
+            if (i < entities.size()) {
+                const u32 slot = *FindSlot(entities[i]);
+                if (m_Entities[slot] != entities[i]) {
+                    m_Entities[slot] = entities[i];
+                    m_AddedTicks[slot] = tick;
+                }
+                m_Components[slot] = value(i);
+                m_ChangedTicks[slot] = tick;
+                ++i;
+            }
+        }
+    }
+
+    // vector::insert constructs element by element through the polymorphic
+    // allocator; trivially copyable data goes in with one memcpy instead
+    template<typename U>
+    static void AppendRange(pmr::Vector<U>& vector, const U* data, usize count) {
+        if constexpr (std::is_trivially_copyable_v<U> && std::is_default_constructible_v<U>) {
+            const usize size = vector.size();
+            vector.resize(size + count);
+            if (count > 0) {
+                std::memcpy(vector.data() + size, data, count * sizeof(U));
+            }
+        } else {
+            vector.insert(vector.end(), data, data + count);
+        }
+    }
+
+    u32* FindSlot(Entity entity) {
+        const u32 index = GetEntityIndex(entity);
+        const usize page = index / SPARSE_PAGE_SIZE;
+        if (page >= m_Pages.size() || !m_Pages[page]) {
+            return nullptr;
+        }
+        return &m_Pages[page][index % SPARSE_PAGE_SIZE];
+    }
+
+    u32& AcquireSlot(Entity entity) {
+        const u32 index = GetEntityIndex(entity);
+        const usize page = index / SPARSE_PAGE_SIZE;
+        if (page >= m_Pages.size()) {
+            m_Pages.resize(page + 1, nullptr);
+        }
+        if (!m_Pages[page]) {
+            void* memory = m_Pages.get_allocator().resource()->allocate(SPARSE_PAGE_SIZE * sizeof(u32), alignof(u32));
+            m_Pages[page] = static_cast<u32*>(memory);
+            std::fill_n(m_Pages[page], SPARSE_PAGE_SIZE, NONE);
+        }
+        return m_Pages[page][index % SPARSE_PAGE_SIZE];
+    }
+
+    void ReleasePages() {
+        std::pmr::memory_resource* resource = m_Pages.get_allocator().resource();
+        for (u32* page : m_Pages) {
+            if (page) {
+                resource->deallocate(page, SPARSE_PAGE_SIZE * sizeof(u32), alignof(u32));
+            }
+        }
+    }
+
+    pmr::Vector<Entity> m_Entities;
+    pmr::Vector<T> m_Components;
+    pmr::Vector<ChangeTick> m_AddedTicks;
+    pmr::Vector<ChangeTick> m_ChangedTicks;
+    pmr::Vector<u32*> m_Pages; // Sparse: entity index -> dense index, NONE if absent
 };
 
 } // namespace ECS
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Enjin/Platform/Platform.h"
+#include "Enjin/ECS/Component.h"
+#include "Enjin/ECS/Entity.h"
+
+namespace Enjin {
+namespace ECS {
+
+// Hierarchy component - makes the entity's TransformComponent relative to its
+// parent's (see TransformSystem). Entities without one are roots.
+struct ENJIN_API HierarchyComponent : public IComponent {
+    Entity parent = INVALID_ENTITY;
+};
+
+} // namespace ECS
+} // namespace Enjin
@@ -15,11 +15,40 @@ struct ENJIN_API TransformComponent : public IComponent {
     Math::Quaternion rotation = Math::Quaternion::Identity();
     Math::Vector3 scale = Math::Vector3(1.0f);
 
+    // Translation * Rotation * Scale, composed directly: the rotation
+    // columns scaled by scale, with position as the last column
     Math::Matrix4 ToMatrix() const {
-        Math::Matrix4 translation = Math::Matrix4::Translation(position);
-        Math::Matrix4 rotationMat = rotation.ToMatrix();
-        Math::Matrix4 scaleMat = Math::Matrix4::Scale(scale);
-        return translation * rotationMat * scaleMat;
+        const f32 xx = rotation.x * rotation.x;
+        const f32 yy = rotation.y * rotation.y;
+        const f32 zz = rotation.z * rotation.z;
+        const f32 xy = rotation.x * rotation.y;
+        const f32 xz = rotation.x * rotation.z;
+        const f32 yz = rotation.y * rotation.z;
+        const f32 wx = rotation.w * rotation.x;
+        const f32 wy = rotation.w * rotation.y;
+        const f32 wz = rotation.w * rotation.z;
+
+        Math::Matrix4 result;
+        result.m[0]  = (1.0f - 2.0f * (yy + zz)) * scale.x;
+        result.m[1]  = 2.0f * (xy + wz) * scale.x;
+        result.m[2]  = 2.0f * (xz - wy) * scale.x;
+        result.m[3]  = 0.0f;
+
+        result.m[4]  = 2.0f * (xy - wz) * scale.y;
+        result.m[5]  = (1.0f - 2.0f * (xx + zz)) * scale.y;
+        result.m[6]  = 2.0f * (yz + wx) * scale.y;
+        result.m[7]  = 0.0f;
+
+        result.m[8]  = 2.0f * (xz + wy) * scale.z;
+        result.m[9]  = 2.0f * (yz - wx) * scale.z;
+        result.m[10] = (1.0f - 2.0f * (xx + yy)) * scale.z;
+        result.m[11] = 0.0f;
+
+        result.m[12] = position.x;
+        result.m[13] = position.y;
+        result.m[14] = position.z;
+        result.m[15] = 1.0f;
+        return result;
     }
 };
 
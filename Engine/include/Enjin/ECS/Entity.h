@@ -2,32 +2,61 @@
 
 #include "Enjin/Platform/Platform.h"
 #include "Enjin/Platform/Types.h"
+#include "Enjin/Memory/MemoryResource.h"
+#include <span>
 
 namespace Enjin {
 namespace ECS {
 
-// Entity is just an ID
+// Entity is a handle: the low 32 bits index per-entity tables, the high 32
+// bits hold the generation of that index when the handle was issued (same
+// layout as SlotHandle64). Generations start at 1, so 0 is never valid.
 using Entity = u64;
 
 // Invalid entity ID
 constexpr Entity INVALID_ENTITY = 0;
 
-// Entity manager - creates and manages entity IDs
+constexpr u32 GetEntityIndex(Entity entity) { return static_cast<u32>(entity); }
+constexpr u32 GetEntityGeneration(Entity entity) { return static_cast<u32>(entity >> 32); }
+constexpr Entity MakeEntity(u32 index, u32 generation) {
+    return (static_cast<Entity>(generation) << 32) | index;
+}
+
+// Entity manager - creates and recycles entity handles.
+// Destroyed indices go on a free list and are reused (most recent first) with
+// a bumped generation, so indices stay compact and handles to destroyed
+// entities fail IsValid in O(1).
 class ENJIN_API EntityManager {
 public:
-    EntityManager();
+    explicit EntityManager(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
     ~EntityManager();
 
     Entity CreateEntity();
     void DestroyEntity(Entity entity);
-    bool IsValid(Entity entity) const;
+
+    // Fills entities with new handles: recycled indices first, then one
+    // block of fresh ones
+    void CreateEntities(std::span<Entity> entities);
+
+    bool IsValid(Entity entity) const {
+        const u32 index = GetEntityIndex(entity);
+        return index < m_Generations.size() && m_Generations[index] == GetEntityGeneration(entity) && entity != INVALID_ENTITY;
+    }
+
+    usize GetAliveCount() const { return m_Generations.size() - m_FreeIndices.size(); }
+    u32 GetIndexCount() const { return static_cast<u32>(m_Generations.size()); } // Upper bound of live indices
 
     void Reset(); // Destroy all entities
 
+    // The whole handle table, for snapshots: Restore() with the same two
+    // arrays reproduces every handle, alive or stale
+    std::span<const u32> GetGenerations() const { return m_Generations; }
+    std::span<const u32> GetFreeIndices() const { return m_FreeIndices; }
+    void Restore(std::span<const u32> generations, std::span<const u32> freeIndices);
+
 private:
-    Entity m_NextEntity = 1;
-    // In a full implementation, you'd track active entities
-    // For now, we use a simple counter
+    pmr::Vector<u32> m_Generations;  // Current generation per index
+    pmr::Vector<u32> m_FreeIndices;  // Destroyed indices, reused LIFO
 };
 
 } // namespace ECS
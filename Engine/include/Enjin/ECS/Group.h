@@ -0,0 +1,152 @@
+#pragma once
+
+#include "Enjin/Platform/Platform.h"
+#include "Enjin/ECS/Entity.h"
+#include "Enjin/ECS/Component.h"
+#include "Enjin/ECS/View.h"
+#include "Enjin/Threading/JobSystem.h"
+#include <algorithm>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file Group.h
+ * @brief Owning groups: entities with all of a set of components, kept packed
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+namespace ECS {
+
+/**
+ * @brief Entities that have all of Ts, stored at the front of each Ts storage
+ *
+ * Obtained from World::Group. The group owns the storages of its types: the
+ * World keeps every matching entity in dense positions [0, Size()) of each
+ * of them, in the same order, by swapping one row per storage whenever an
+ * entity starts or stops matching. Each() then walks those aligned prefixes
+ * side by side, with no sparse lookups and no per-entity checks.
+ *
+ * A storage can be owned by at most one group. A request that would share
+ * one with an existing, different group, and every request in Archetype mode
+ * (where chunks already pack entities by component set), gets an ordinary
+ * view over the same components instead; IsPacked() tells them apart.
+ *
+ * As with views, request a component as const for read-only access;
+ * non-const components are stamped as changed for every entity visited. Hold
+ * a group only where it is used, and record structural changes made during
+ * Each() into World::GetCommandBuffer().
+ *
+ * @example
+ * world.Group<const TransformComponent, const MeshComponent>().Each(
+ *     [](Entity entity, const TransformComponent& transform, const MeshComponent& mesh) { ... });
+ */
+template<typename... Ts>
+class ComponentGroup {
+    static_assert(sizeof...(Ts) > 1, "A group needs at least two component types; use a view for one");
+
+    template<typename T>
+    using StoragePtr = std::conditional_t<std::is_const_v<T>,
+                                          const ComponentStorage<std::remove_const_t<T>>*,
+                                          ComponentStorage<std::remove_const_t<T>>*>;
+
+    template<usize I>
+    using TypeAt = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+public:
+    using FallbackView = ComponentView<TypeList<Ts...>, TypeList<>>;
+
+    // Packed: size points at the World's count of grouped entities
+    ComponentGroup(std::tuple<StoragePtr<Ts>...> storages, const usize* size, ChangeTick tick)
+        : m_Storages(storages), m_Size(size), m_Tick(tick) {}
+
+    // Not packed; every call is forwarded to view
+    explicit ComponentGroup(const FallbackView& view)
+        : m_Fallback(view) {}
+
+    bool IsPacked() const { return m_Size != nullptr; }
+
+    // Exact when packed; an upper bound otherwise (see ComponentView::SizeHint)
+    usize Size() const {
+        return m_Size ? *m_Size : m_Fallback->SizeHint();
+    }
+
+    // The grouped entities in iteration order; empty when not packed
+    std::span<const Entity> GetEntities() const {
+        if (!m_Size) {
+            return {};
+        }
+        return { std::get<0>(m_Storages)->GetEntities().data(), *m_Size };
+    }
+
+    /**
+     * @brief Call func(entity, Ts&...) or func(Ts&...) for every entity
+     */
+    template<typename Func>
+    void Each(Func&& func) const {
+        if (!m_Size) {
+            m_Fallback->Each(std::forward<Func>(func));
+            return;
+        }
+        EachInRange(func, 0, *m_Size, std::index_sequence_for<Ts...>{});
+    }
+
+    /**
+     * @brief Each() split across the JobSystem workers
+     *
+     * Same rules as ComponentView::ParallelEach.
+     *
+     * @param grainSize Entities per job; 0 lets ParallelFor choose
+     */
+    template<typename Func>
+    void ParallelEach(Func&& func, usize grainSize = 0) const {
+        if (!m_Size) {
+            m_Fallback->ParallelEach(std::forward<Func>(func), grainSize);
+            return;
+        }
+        JobSystem::ParallelFor(*m_Size, [this, &func](usize begin, usize end) {
+            EachInRange(func, begin, end, std::index_sequence_for<Ts...>{});
+        }, grainSize);
+    }
+
+private:
+    template<typename Func>
+    static ENJIN_FORCE_INLINE void Invoke(Func& func, Entity entity, Ts&... components) {
+        if constexpr (std::is_invocable_v<Func&, Entity, Ts&...>) {
+            func(entity, components...);
+        } else {
+            func(components...);
+        }
+    }
+
+    template<usize I>
+    void StampRange(usize begin, usize end) const {
+        if constexpr (!std::is_const_v<TypeAt<I>>) {
+            ChangeTick* ticks = std::get<I>(m_Storages)->GetChangedTicks().data();
+            std::fill(ticks + begin, ticks + end, m_Tick);
+        }
+    }
+
+    // Position i holds the same entity in every storage
+    template<typename Func, usize... I>
+    void EachInRange(Func& func, usize begin, usize end, std::index_sequence<I...>) const {
+        const Entity* entities = std::get<0>(m_Storages)->GetEntities().data();
+        const std::tuple<Ts*...> data(std::get<I>(m_Storages)->GetComponents().data()...);
+        (StampRange<I>(begin, end), ...);
+        for (usize i = begin; i < end; ++i) {
+            Invoke(func, entities[i], std::get<I>(data)[i]...);
+        }
+    }
+
+    std::tuple<StoragePtr<Ts>...> m_Storages{};
+    const usize* m_Size = nullptr;
+    ChangeTick m_Tick = 0; // Stamped on non-const components the group hands out
+    std::optional<FallbackView> m_Fallback;
+};
+
+} // namespace ECS
+} // namespace Enjin
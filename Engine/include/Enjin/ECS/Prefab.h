@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Enjin/Platform/Platform.h"
+#include "Enjin/ECS/Entity.h"
+#include "Enjin/ECS/Component.h"
+#include "Enjin/ECS/World.h"
+#include "Enjin/Memory/MemoryResource.h"
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+
+/**
+ * @file Prefab.h
+ * @brief Entity templates: a component bundle cloned by World::Instantiate
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+namespace ECS {
+
+/**
+ * @brief A set of component values that World::Instantiate stamps onto new entities
+ *
+ * The values live in one compact blob, each at its type's alignment, with a
+ * small column table describing them. Instantiating N entities copies each
+ * value into its storage as one run of N (a fill of the storage's dense
+ * array in SparseSet mode, of the new rows' chunk columns in Archetype mode),
+ * so the cost is one pass per component type rather than one AddComponent
+ * per entity and type.
+ *
+ * A prefab is independent of any World and can be instantiated into several.
+ *
+ * @example
+ * Prefab crate;
+ * crate.Add<TransformComponent>().Add<Health>(Health{ 50 }).Add<Breakable>();
+ * std::vector<Entity> crates(512);
+ * world.Instantiate(crate, crates, placements); // placements: one TransformComponent each
+ */
+class ENJIN_API Prefab {
+public:
+    // One component value in the blob
+    struct Column {
+        const ComponentTypeInfo* info = nullptr;
+        u32 offset = 0; // Of the value inside the blob
+        // Copy-constructs count copies of value at dst
+        void (*fill)(void* dst, const void* value, usize count) = nullptr;
+        // Appends value to the World's storage for every entity (SparseSet mode)
+        void (*append)(World& world, std::span<const Entity> entities, const void* value, ChangeTick tick) = nullptr;
+    };
+
+    explicit Prefab(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    ~Prefab();
+
+    Prefab(Prefab&& other) noexcept;
+    Prefab& operator=(Prefab&& other) noexcept;
+    Prefab(const Prefab&) = delete;
+    Prefab& operator=(const Prefab&) = delete;
+
+    // Set the value instances get for T, replacing any earlier one
+    template<typename T>
+    Prefab& Add(const T& component = T{}) {
+        static_assert(std::is_copy_constructible_v<T>, "Prefab components are copied into every instance");
+        void* slot = Acquire(ComponentRegistry::GetTypeInfo<T>(), &Fill<T>, &Append<T>);
+        new (slot) T(component);
+        return *this;
+    }
+
+    template<typename T>
+    bool Has() const {
+        return m_Mask.Test(ComponentRegistry::GetTypeId<T>());
+    }
+
+    template<typename T>
+    const T* Get() const {
+        const Column* column = FindColumn(ComponentRegistry::GetTypeId<T>());
+        return column ? static_cast<const T*>(GetValue(*column)) : nullptr;
+    }
+
+    const ComponentMask& GetMask() const { return m_Mask; }
+    std::span<const Column> GetColumns() const { return m_Columns; }
+    const void* GetValue(const Column& column) const { return m_Data + column.offset; }
+
+    // Bytes of component data in the blob, padding included
+    usize GetDataSize() const { return m_Size; }
+
+private:
+    using FillFn = decltype(Column::fill);
+    using AppendFn = decltype(Column::append);
+
+    template<typename T>
+    static void Fill(void* dst, const void* value, usize count) {
+        std::uninitialized_fill_n(static_cast<T*>(dst), count, *static_cast<const T*>(value));
+    }
+
+    template<typename T>
+    static void Append(World& world, std::span<const Entity> entities, const void* value, ChangeTick tick) {
+        world.GetOrCreateStorage<T>()->Add(entities, *static_cast<const T*>(value), tick);
+    }
+
+    // Uninitialized slot for the type's value: the old value destroyed in
+    // place, or a new one at the end of the blob
+    void* Acquire(const ComponentTypeInfo& info, FillFn fill, AppendFn append);
+    const Column* FindColumn(ComponentTypeId typeId) const;
+    void Release();
+
+    std::pmr::memory_resource* m_Resource;
+    pmr::Vector<Column> m_Columns;
+    ComponentMask m_Mask;
+    u8* m_Data = nullptr;
+    usize m_Size = 0;
+    usize m_Capacity = 0;
+    usize m_Alignment = alignof(std::max_align_t); // Of m_Data: the largest value alignment
+};
+
+} // namespace ECS
+} // namespace Enjin
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "Enjin/Platform/Platform.h"
+#include "Enjin/Platform/MappedFile.h"
+#include "Enjin/ECS/Entity.h"
+#include "Enjin/ECS/Component.h"
+#include "Enjin/Memory/MemoryResource.h"
+#include <cstdio>
+#include <span>
+#include <string>
+
+/**
+ * @file Snapshot.h
+ * @brief Binary World snapshots: the entity table plus raw component columns
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+namespace ECS {
+
+constexpr u32 SNAPSHOT_MAGIC = 0x534A4E45; // "ENJS"
+constexpr u32 SNAPSHOT_VERSION = 1;
+
+/**
+ * @brief Start of a snapshot file
+ *
+ * Layout: header, entity generations (u32 each), free indices (u32 each),
+ * then per component table its entities and its components, each array
+ * aligned for direct use from the mapped file, and finally the table
+ * directory. Components are stored as raw bytes in native byte order, so a
+ * snapshot is only meant to be read by a build of the same engine on the
+ * same platform. The magic is written last; an interrupted save leaves a
+ * file that fails to open.
+ */
+struct SnapshotHeader {
+    u32 magic = 0;
+    u32 version = 0;
+    u32 generationCount = 0;
+    u32 freeCount = 0;
+    u32 tableCount = 0;
+    u32 reserved = 0;
+    u64 generationsOffset = 0;
+    u64 freeOffset = 0;
+    u64 tablesOffset = 0;
+    u64 fileSize = 0;
+};
+
+// One component type's column
+struct SnapshotTable {
+    ComponentTypeHash hash = 0; // ComponentRegistry::GetTypeHash<T>()
+    u32 size = 0;               // sizeof(T) when written
+    u32 alignment = 0;          // alignof(T) when written
+    u64 count = 0;
+    u64 entitiesOffset = 0;     // Entity[count]
+    u64 componentsOffset = 0;   // T[count]
+};
+
+/**
+ * @brief Streams a snapshot to disk
+ *
+ * Used by World::SaveSnapshot. Each table is written as BeginTable, any
+ * number of WriteEntities calls, the same number of rows through
+ * WriteComponents, then EndTable.
+ */
+class ENJIN_API SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    ~SnapshotWriter();
+
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    // Creates the file and writes the entity table
+    bool Open(const std::string& path, std::span<const u32> generations, std::span<const u32> freeIndices);
+
+    void BeginTable(ComponentTypeHash hash, u32 size, u32 alignment);
+    void WriteEntities(const Entity* entities, usize count);
+    void WriteComponents(const void* components, usize count);
+    void EndTable();
+
+    // Writes the table directory and header; false if any write failed
+    bool Close();
+
+private:
+    void Write(const void* data, usize bytes);
+    void Pad(usize alignment);
+
+    std::FILE* m_File = nullptr;
+    std::string m_Path;
+    u64 m_Offset = 0;
+    bool m_Failed = false;
+    SnapshotHeader m_Header;
+    SnapshotTable m_Table;       // Being written
+    u64 m_ComponentRows = 0;     // Rows of m_Table's components written so far
+    pmr::Vector<SnapshotTable> m_Tables;
+};
+
+/**
+ * @brief A snapshot mapped into memory
+ *
+ * Open() maps the file and checks that every array lies inside it and every
+ * table entity exists in the entity table. Nothing is parsed or copied: the
+ * accessors point straight into the mapping and stay valid while the reader
+ * is open.
+ */
+class ENJIN_API SnapshotReader {
+public:
+    bool Open(const std::string& path);
+    void Close() { m_File.Close(); }
+
+    std::span<const u32> GetGenerations() const;
+    std::span<const u32> GetFreeIndices() const;
+    std::span<const SnapshotTable> GetTables() const;
+
+    // The table for a component type; nullptr if the snapshot has none or
+    // its layout differs from the given one (the type changed since saving)
+    const SnapshotTable* FindTable(ComponentTypeHash hash, u32 size, u32 alignment) const;
+
+    std::span<const Entity> GetEntities(const SnapshotTable& table) const;
+    const void* GetComponents(const SnapshotTable& table) const { return m_File.GetData() + table.componentsOffset; }
+
+private:
+    bool Validate(const std::string& path) const;
+    const SnapshotHeader& GetHeader() const { return *reinterpret_cast<const SnapshotHeader*>(m_File.GetData()); }
+
+    Platform::MappedFile m_File;
+};
+
+} // namespace ECS
+} // namespace Enjin
@@ -3,8 +3,10 @@
 #include "Enjin/Platform/Platform.h"
 #include "Enjin/ECS/Entity.h"
 #include "Enjin/ECS/Component.h"
+#include <atomic>
 #include <vector>
 #include <memory>
+#include <type_traits>
 
 namespace Enjin {
 namespace ECS {
@@ -12,37 +14,186 @@ namespace ECS {
 // Forward declaration
 class World;
 
+/**
+ * @brief Components a system reads and writes during Update
+ *
+ * SystemManager runs two systems concurrently only if neither writes a
+ * component the other touches. An exclusive system conflicts with everything
+ * and runs alone on the thread that calls World::Update.
+ */
+class ENJIN_API SystemAccess {
+public:
+    template<typename... Ts>
+    SystemAccess& Read() {
+        (Add(m_Reads, ComponentRegistry::GetTypeId<std::remove_const_t<Ts>>()), ...);
+        return *this;
+    }
+
+    template<typename... Ts>
+    SystemAccess& Write() {
+        (Add(m_Writes, ComponentRegistry::GetTypeId<std::remove_const_t<Ts>>()), ...);
+        return *this;
+    }
+
+    /**
+     * @brief Shared state outside the component storages (a system's output
+     *        buffers, a cache), named by any type
+     *
+     * Ordered like components but keyed by the type's name hash, so it uses
+     * no ComponentTypeId and registers nothing.
+     *
+     * @example
+     * access.Read<TransformComponent>().WriteResource<TransformSystem>();
+     */
+    template<typename... Ts>
+    SystemAccess& ReadResource() {
+        (Add(m_ResourceReads, ComponentRegistry::GetTypeHash<std::remove_const_t<Ts>>()), ...);
+        return *this;
+    }
+
+    template<typename... Ts>
+    SystemAccess& WriteResource() {
+        (Add(m_ResourceWrites, ComponentRegistry::GetTypeHash<std::remove_const_t<Ts>>()), ...);
+        return *this;
+    }
+
+    // For systems that change entity structure directly (rather than via
+    // command buffers) or use main-thread-only APIs (rendering, windowing)
+    SystemAccess& Exclusive() {
+        m_Exclusive = true;
+        return *this;
+    }
+
+    bool IsExclusive() const { return m_Exclusive; }
+    bool ConflictsWith(const SystemAccess& other) const;
+
+    const std::vector<ComponentTypeId>& GetReads() const { return m_Reads; }
+    const std::vector<ComponentTypeId>& GetWrites() const { return m_Writes; }
+    const std::vector<ComponentTypeHash>& GetResourceReads() const { return m_ResourceReads; }
+    const std::vector<ComponentTypeHash>& GetResourceWrites() const { return m_ResourceWrites; }
+
+private:
+    static void Add(std::vector<ComponentTypeId>& types, ComponentTypeId type);
+    static void Add(std::vector<ComponentTypeHash>& resources, ComponentTypeHash resource);
+
+    std::vector<ComponentTypeId> m_Reads;
+    std::vector<ComponentTypeId> m_Writes;
+    std::vector<ComponentTypeHash> m_ResourceReads;
+    std::vector<ComponentTypeHash> m_ResourceWrites;
+    bool m_Exclusive = false;
+};
+
 // Base system interface
 class ENJIN_API ISystem {
 public:
     virtual ~ISystem() = default;
     virtual void Update(f32 deltaTime) = 0;
+
+    // The entity started matching the signature (see DeclareSignature)
     virtual void OnEntityAdded(Entity entity) {}
+
+    // The entity stops matching the signature; called while it still has
+    // its components, before the removal or destruction takes effect
     virtual void OnEntityRemoved(Entity entity) {}
+
+    /**
+     * @brief Components an entity needs for this system to be notified about it
+     *
+     * Called once at registration. OnEntityAdded and OnEntityRemoved only
+     * fire when an entity starts or stops having all of them, so a system
+     * doesn't hear about components it doesn't care about. The default,
+     * empty signature matches any entity with at least one component.
+     *
+     * @example
+     * void DeclareSignature(ComponentMask& signature) override {
+     *     signature = ComponentMask::Of<TransformComponent, MeshComponent>();
+     * }
+     */
+    virtual void DeclareSignature(ComponentMask& signature) {}
+
+    /**
+     * @brief Declare the components Update touches
+     *
+     * Called once before the first scheduled Update. Systems that don't override
+     * it are exclusive, so they keep running alone, in registration order.
+     * A non-exclusive system must not change entity structure directly in
+     * Update; it records changes into World::GetCommandBuffer() instead.
+     *
+     * @example
+     * void DeclareAccess(SystemAccess& access) override {
+     *     access.Read<VelocityComponent>().Write<TransformComponent>();
+     * }
+     */
+    virtual void DeclareAccess(SystemAccess& access) { access.Exclusive(); }
+
+    /**
+     * @brief World change tick at the end of this system's previous Update
+     *
+     * 0 before the first Update. Pass it to a view's Changed<T>() or
+     * Added<T>() to visit only what changed since then; the system's own
+     * writes from that run are not included.
+     */
+    ChangeTick GetLastRunTick() const { return m_LastRunTick; }
+
+private:
+    friend class SystemManager;
+
+    ChangeTick m_LastRunTick = 0;
 };
 
-// System manager - manages all systems
+/**
+ * @brief Owns the systems and runs them each frame
+ *
+ * Update follows registration order wherever two systems conflict; systems
+ * that don't conflict run concurrently on the JobSystem workers. The
+ * dependency graph is built once per registration, not per frame. Without
+ * an initialized JobSystem every system runs serially on the caller.
+ */
 class ENJIN_API SystemManager {
 public:
-    SystemManager();
+    // changeTick is the owning World's, advanced around every system update
+    explicit SystemManager(std::atomic<ChangeTick>& changeTick);
     ~SystemManager();
 
     template<typename T, typename... Args>
     T* RegisterSystem(Args&&... args) {
         static_assert(std::is_base_of_v<ISystem, T>, "T must inherit from ISystem");
-        
+
         auto system = std::make_unique<T>(std::forward<Args>(args)...);
         T* ptr = system.get();
+        ComponentMask signature;
+        ptr->DeclareSignature(signature);
         m_Systems.push_back(std::move(system));
+        m_Signatures.push_back(signature);
+        m_GraphDirty = true;
         return ptr;
     }
 
     void Update(f32 deltaTime);
-    void OnEntityAdded(Entity entity);
-    void OnEntityRemoved(Entity entity);
+
+    bool HasSystems() const { return !m_Systems.empty(); }
+
+    /**
+     * @brief Notify systems whose signature entity starts or stops matching
+     * @param before Components of entity before the change
+     * @param after Components of entity after it; empty when destroyed
+     */
+    void OnComponentsChanged(Entity entity, const ComponentMask& before, const ComponentMask& after);
 
 private:
+    struct Node;
+
+    void BuildGraph();
+    void RunSystem(ISystem& system, f32 deltaTime);
+    void RunBatch(usize begin, usize end);
+    static void RunNode(void* data);
+
+    std::atomic<ChangeTick>& m_ChangeTick;
     std::vector<std::unique_ptr<ISystem>> m_Systems;
+    std::vector<ComponentMask> m_Signatures; // Parallel to m_Systems
+    std::unique_ptr<Node[]> m_Nodes; // Parallel to m_Systems
+    bool m_GraphDirty = false;
+    f32 m_DeltaTime = 0.0f;          // For the jobs of the running Update
 };
 
 } // namespace ECS
@@ -5,6 +5,7 @@
 #include "Enjin/ECS/World.h"
 #include "Enjin/ECS/Components/Transform.h"
 #include "Enjin/ECS/Components/Mesh.h"
+#include "Enjin/ECS/Systems/TransformSystem.h"
 #include "Enjin/Renderer/Vulkan/VulkanRenderer.h"
 #include "Enjin/Renderer/Vulkan/VulkanPipeline.h"
 #include "Enjin/Renderer/Vulkan/VulkanBuffer.h"
@@ -22,6 +23,7 @@ struct EntityRenderData {
     std::unique_ptr<Renderer::VulkanBuffer> vertexBuffer;
     std::unique_ptr<Renderer::VulkanBuffer> indexBuffer;
     u32 indexCount = 0;
+    Math::Matrix4 model; // Rebuilt only when the entity's transform changes
 };
 
 // Render system - renders entities with Transform and Mesh components
@@ -36,21 +38,27 @@ public:
     void Update(f32 deltaTime) override;
     void OnEntityAdded(Entity entity) override;
     void OnEntityRemoved(Entity entity) override;
+    void DeclareSignature(ComponentMask& signature) override;
 
     void SetCamera(Renderer::Camera* camera) { m_Camera = camera; }
 
+    // Draw with the hierarchy's world matrices instead of local transforms
+    void SetTransformSystem(const TransformSystem* transforms) { m_Transforms = transforms; }
+
 private:
-    void RenderEntity(Entity entity);
+    void RenderEntity(Entity entity, const MeshComponent& mesh);
     void CreateTriangleMesh();
     void CreatePipeline();
     void CreateUniformBuffers();
     void CreateDescriptorSets();
-    void UpdateUniformBuffer(Entity entity);
+    void UpdateModelMatrices();
+    void UpdateUniformBuffer(const Math::Matrix4& model);
     void SetupEntityBuffers(Entity entity);
 
     World* m_World = nullptr;
     Renderer::VulkanRenderer* m_Renderer = nullptr;
     Renderer::Camera* m_Camera = nullptr;
+    const TransformSystem* m_Transforms = nullptr;
     Entity m_TriangleEntity = INVALID_ENTITY;
 
     // Rendering resources
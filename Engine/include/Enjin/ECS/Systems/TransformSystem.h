@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Enjin/Platform/Platform.h"
+#include "Enjin/ECS/System.h"
+#include "Enjin/ECS/World.h"
+#include "Enjin/ECS/Components/Transform.h"
+#include "Enjin/ECS/Components/Hierarchy.h"
+#include "Enjin/Math/Matrix.h"
+#include "Enjin/Memory/MemoryResource.h"
+#include <span>
+
+/**
+ * @file TransformSystem.h
+ * @brief World matrices for parent/child transform hierarchies
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+namespace ECS {
+
+/**
+ * @brief Computes a world matrix for every entity with a TransformComponent
+ *
+ * Local and world matrices live in structure-of-arrays form, sorted by
+ * depth in the hierarchy: roots first, then their children, and so on, so
+ * every parent's world matrix is final before any of its children is read.
+ *
+ * Each Update only rebuilds the local matrices of transforms changed since
+ * the previous Update (see View::Changed) and only recomputes world matrices
+ * below them; a frame where nothing moved costs one pass over a byte array.
+ * Levels are processed in order, and the entities of a level in parallel on
+ * the JobSystem.
+ *
+ * The sorted layout is rebuilt when a TransformComponent is added or
+ * removed, a HierarchyComponent is added, written or removed, or a tracked
+ * entity is destroyed. A parent without a TransformComponent, or a
+ * destroyed one, leaves the child as a root.
+ *
+ * World matrices are rewritten during Update: systems that read them
+ * declare access.ReadResource<TransformSystem>() so the scheduler orders them after
+ * this system.
+ *
+ * @example
+ * auto* transforms = world.RegisterSystem<TransformSystem>(&world);
+ * world.AddComponent<HierarchyComponent>(wheel).parent = car;
+ * world.Update(dt);
+ * const Math::Matrix4* wheelToWorld = transforms->GetWorldMatrix(wheel);
+ */
+class ENJIN_API TransformSystem : public ISystem {
+public:
+    explicit TransformSystem(World* world);
+
+    void Update(f32 deltaTime) override;
+    void OnEntityRemoved(Entity entity) override;
+    void DeclareSignature(ComponentMask& signature) override;
+    void DeclareAccess(SystemAccess& access) override;
+
+    // nullptr if the entity has no TransformComponent as of the last Update
+    const Math::Matrix4* GetWorldMatrix(Entity entity) const;
+
+    // Depth-sorted; parallel to GetWorldMatrices()
+    std::span<const Entity> GetEntities() const { return m_Entities; }
+    std::span<const Math::Matrix4> GetWorldMatrices() const { return m_WorldMatrices; }
+
+    // Depth of the deepest entity plus one
+    u32 GetLevelCount() const { return m_LevelOffsets.empty() ? 0 : static_cast<u32>(m_LevelOffsets.size() - 1); }
+
+    // Force a rebuild of the sorted layout on the next Update
+    void Invalidate() { m_LayoutDirty = true; }
+
+private:
+    static constexpr u32 NONE = ~0u;
+
+    bool NeedsRebuild() const;
+    void Rebuild();
+    void UpdateLocalMatrices();
+    void PropagateLevel(u32 begin, u32 end);
+    u32  FindSlot(Entity entity) const;
+
+    World* m_World = nullptr;
+
+    // Parallel, sorted by depth
+    pmr::Vector<Entity> m_Entities;
+    pmr::Vector<u32> m_Parents;               // Slot of the parent, NONE for roots
+    pmr::Vector<Math::Matrix4> m_LocalMatrices;
+    pmr::Vector<Math::Matrix4> m_WorldMatrices;
+    pmr::Vector<u8> m_Dirty;                  // World matrix must be recomputed (or was, this Update)
+
+    pmr::Vector<u32> m_LevelOffsets;          // Level d is [m_LevelOffsets[d], m_LevelOffsets[d + 1])
+    pmr::Vector<u32> m_SlotByIndex;           // GetEntityIndex(entity) -> slot, NONE if untracked
+    usize m_HierarchyCount = 0;               // HierarchyComponents at the last rebuild
+    bool m_LayoutDirty = true;
+};
+
+} // namespace ECS
+} // namespace Enjin
@@ -0,0 +1,392 @@
+#pragma once
+
+#include "Enjin/Platform/Platform.h"
+#include "Enjin/ECS/Entity.h"
+#include "Enjin/ECS/Component.h"
+#include "Enjin/ECS/Archetype.h"
+#include "Enjin/Threading/JobSystem.h"
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file View.h
+ * @brief Multi-component queries over a World: include and exclude filters
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+namespace ECS {
+
+template<typename... Ts>
+struct TypeList {};
+
+// Components an entity must not have to match a view
+template<typename... Ts>
+struct ExcludeList {};
+
+template<typename... Ts>
+inline constexpr ExcludeList<Ts...> Exclude{};
+
+template<typename Include, typename Excluded>
+class ComponentView;
+
+/**
+ * @brief Entities that have all of Ts and none of Xs
+ *
+ * Obtained from World::View. In SparseSet mode Each() walks the smallest
+ * included storage and probes the others through their sparse arrays; in
+ * Archetype mode it walks the chunks of every matching archetype. Both loops
+ * are fully templated, with no virtual calls per entity.
+ *
+ * Request a component as const (View<const MeshComponent>) for read-only
+ * access; a const World only hands out views of const components. Non-const
+ * components are stamped as changed at the world's current tick for every
+ * entity Each() visits, whether or not func writes them, so ask for const
+ * wherever possible. Changed<T>() and Added<T>() narrow a view to entities
+ * whose T was written or added after a given tick.
+ *
+ * A view holds raw storage pointers: create it where it is used, and don't
+ * add/remove components or destroy entities inside Each(); record them in
+ * World::GetCommandBuffer() instead. ParallelEach() spreads the same loop
+ * over the JobSystem workers.
+ *
+ * @example
+ * world.View<TransformComponent, const MeshComponent>(Exclude<HiddenTag>)
+ *     .Each([](Entity entity, TransformComponent& transform, const MeshComponent& mesh) {
+ *         ...
+ *     });
+ *
+ * // In a system: only transforms written since this system last ran
+ * world.View<const TransformComponent>().Changed<TransformComponent>(GetLastRunTick())
+ *     .Each([](Entity entity, const TransformComponent& transform) { ... });
+ */
+template<typename... Ts, typename... Xs>
+class ComponentView<TypeList<Ts...>, TypeList<Xs...>> {
+    static_assert(sizeof...(Ts) > 0, "A view needs at least one component type");
+
+    template<typename T>
+    using StoragePtr = std::conditional_t<std::is_const_v<T>,
+                                          const ComponentStorage<std::remove_const_t<T>>*,
+                                          ComponentStorage<std::remove_const_t<T>>*>;
+    using ExcludePtrs = std::tuple<const ComponentStorage<std::remove_const_t<Xs>>*...>;
+
+    template<usize I>
+    using TypeAt = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+public:
+    // SparseSet mode; a null include storage makes the view empty
+    ComponentView(std::tuple<StoragePtr<Ts>...> storages, ExcludePtrs excludes, ChangeTick tick)
+        : m_Storages(storages), m_Excludes(excludes), m_Tick(tick) {}
+
+    // Archetype mode
+    ComponentView(const ArchetypeStorage* archetypes, ChangeTick tick)
+        : m_Archetypes(archetypes), m_Tick(tick) {}
+
+    /**
+     * @brief Only entities whose T was written after since
+     *
+     * T must be one of the view's components. Pass ISystem::GetLastRunTick()
+     * to see what changed since the calling system last ran. Filters on
+     * different components combine; a second filter on the same component
+     * replaces the first.
+     */
+    template<typename T>
+    ComponentView Changed(ChangeTick since) const {
+        return WithFilter<T>(TickFilter::Changed, since);
+    }
+
+    // Only entities whose T was added after since (see Changed)
+    template<typename T>
+    ComponentView Added(ChangeTick since) const {
+        return WithFilter<T>(TickFilter::Added, since);
+    }
+
+    /**
+     * @brief Call func(entity, Ts&...) or func(Ts&...) for every match
+     */
+    template<typename Func>
+    void Each(Func&& func) const {
+        if (m_Archetypes) {
+            const ComponentTypeId excluded[] = { ComponentRegistry::GetTypeId<std::remove_const_t<Xs>>()..., 0 };
+            m_Archetypes->ForEachMatchingChunk<Ts...>([this, &func](const Archetype& archetype, usize chunk, const i32* columns) {
+                EachInChunk(func, archetype, chunk, columns, std::index_sequence_for<Ts...>{});
+            }, std::span<const ComponentTypeId>(excluded, sizeof...(Xs)));
+            return;
+        }
+
+        const usize lead = FindLead();
+        if (lead == NO_LEAD) {
+            return;
+        }
+        DispatchLead(func, lead, 0, LeadSize(lead, std::index_sequence_for<Ts...>{}), std::index_sequence_for<Ts...>{});
+    }
+
+    /**
+     * @brief Each() split across the JobSystem workers
+     *
+     * func runs concurrently for different entities, so it may only write the
+     * components it is handed (and must not change entity structure).
+     *
+     * @param grainSize Entities per job (SparseSet) or chunks per job
+     *                  (Archetype); 0 lets ParallelFor choose
+     */
+    template<typename Func>
+    void ParallelEach(Func&& func, usize grainSize = 0) const {
+        if (m_Archetypes) {
+            struct ChunkRef {
+                const Archetype* archetype;
+                usize chunk;
+                std::array<i32, sizeof...(Ts)> columns;
+            };
+            pmr::Vector<ChunkRef> chunks;
+            const ComponentTypeId excluded[] = { ComponentRegistry::GetTypeId<std::remove_const_t<Xs>>()..., 0 };
+            m_Archetypes->ForEachMatchingChunk<Ts...>([&chunks](const Archetype& archetype, usize chunk, const i32* columns) {
+                ChunkRef& ref = chunks.emplace_back(ChunkRef{ &archetype, chunk, {} });
+                std::copy_n(columns, sizeof...(Ts), ref.columns.begin());
+            }, std::span<const ComponentTypeId>(excluded, sizeof...(Xs)));
+
+            JobSystem::ParallelFor(chunks.size(), [this, &func, &chunks](usize begin, usize end) {
+                for (usize chunk = begin; chunk < end; ++chunk) {
+                    const ChunkRef& ref = chunks[chunk];
+                    EachInChunk(func, *ref.archetype, ref.chunk, ref.columns.data(), std::index_sequence_for<Ts...>{});
+                }
+            }, grainSize);
+            return;
+        }
+
+        const usize lead = FindLead();
+        if (lead == NO_LEAD) {
+            return;
+        }
+        JobSystem::ParallelFor(LeadSize(lead, std::index_sequence_for<Ts...>{}), [this, &func, lead](usize begin, usize end) {
+            DispatchLead(func, lead, begin, end, std::index_sequence_for<Ts...>{});
+        }, grainSize);
+    }
+
+    bool Contains(Entity entity) const {
+        if (m_Archetypes) {
+            const EntityLocation* location = m_Archetypes->GetLocation(entity);
+            const Archetype* archetype = location ? location->archetype : nullptr;
+            if (!archetype || !(archetype->Has(ComponentRegistry::GetTypeId<std::remove_const_t<Ts>>()) && ...) ||
+                (archetype->Has(ComponentRegistry::GetTypeId<std::remove_const_t<Xs>>()) || ...)) {
+                return false;
+            }
+            return !m_Filtered || PassesRow(*archetype, location->row, std::index_sequence_for<Ts...>{});
+        }
+        if (FindLead() == NO_LEAD || !HasAll(entity, std::index_sequence_for<Ts...>{}) || IsExcluded(entity)) {
+            return false;
+        }
+        return !m_Filtered || PassesEntity(entity, std::index_sequence_for<Ts...>{});
+    }
+
+    // Upper bound on the number of matches: the smallest included storage
+    // (SparseSet) or the size of all matching archetypes (Archetype). Tick
+    // filters are not taken into account.
+    usize SizeHint() const {
+        if (m_Archetypes) {
+            usize count = 0;
+            for (const Archetype* archetype : m_Archetypes->GetArchetypes()) {
+                if ((archetype->Has(ComponentRegistry::GetTypeId<std::remove_const_t<Ts>>()) && ...)) {
+                    count += archetype->GetEntityCount();
+                }
+            }
+            return count;
+        }
+        const usize lead = FindLead();
+        return lead == NO_LEAD ? 0 : LeadSize(lead, std::index_sequence_for<Ts...>{});
+    }
+
+private:
+    static constexpr usize NO_LEAD = ~usize(0);
+
+    enum class TickFilter : u8 { None, Added, Changed };
+
+    template<typename T>
+    static constexpr usize IndexOf() {
+        constexpr bool matches[] = { std::is_same_v<std::remove_const_t<T>, std::remove_const_t<Ts>>... };
+        for (usize i = 0; i < sizeof...(Ts); ++i) {
+            if (matches[i]) {
+                return i;
+            }
+        }
+        return NO_LEAD;
+    }
+
+    template<typename T>
+    ComponentView WithFilter(TickFilter filter, ChangeTick since) const {
+        constexpr usize index = IndexOf<T>();
+        static_assert(index != NO_LEAD, "Changed/Added filters need a component of the view");
+        ComponentView view = *this;
+        view.m_Filters[index] = filter;
+        view.m_Since[index] = since;
+        view.m_Filtered = true;
+        return view;
+    }
+
+    ENJIN_FORCE_INLINE bool Passes(usize component, ChangeTick added, ChangeTick changed) const {
+        switch (m_Filters[component]) {
+            case TickFilter::Added:   return IsTickNewer(added, m_Since[component]);
+            case TickFilter::Changed: return IsTickNewer(changed, m_Since[component]);
+            default:                  return true;
+        }
+    }
+
+    template<usize I>
+    ENJIN_FORCE_INLINE void Stamp(ChangeTick& tick) const {
+        if constexpr (!std::is_const_v<TypeAt<I>>) {
+            tick = m_Tick;
+        }
+    }
+
+    template<usize I>
+    ENJIN_FORCE_INLINE void StampChunk(ChangeTick* ticks, u32 count) const {
+        if constexpr (!std::is_const_v<TypeAt<I>>) {
+            std::fill_n(ticks, count, m_Tick);
+        }
+    }
+
+    template<typename Func>
+    static ENJIN_FORCE_INLINE void Invoke(Func& func, Entity entity, Ts&... components) {
+        if constexpr (std::is_invocable_v<Func&, Entity, Ts&...>) {
+            func(entity, components...);
+        } else {
+            func(components...);
+        }
+    }
+
+    // Visits one archetype chunk; columns[I] is the column of the I-th of Ts
+    template<typename Func, usize... I>
+    void EachInChunk(Func& func, const Archetype& archetype, usize chunk, const i32* columns, std::index_sequence<I...>) const {
+        const u32 count = archetype.GetChunkRowCount(chunk);
+        const Entity* entities = archetype.GetEntities(chunk);
+        const std::tuple<Ts*...> data(static_cast<Ts*>(archetype.GetColumnData(chunk, columns[I]))...);
+        ChangeTick* const changed[] = { archetype.GetChangedTicks(chunk, columns[I])... };
+
+        if (!m_Filtered) {
+            (StampChunk<I>(changed[I], count), ...);
+            for (u32 i = 0; i < count; ++i) {
+                Invoke(func, entities[i], std::get<I>(data)[i]...);
+            }
+            return;
+        }
+
+        const ChangeTick* const added[] = { archetype.GetAddedTicks(chunk, columns[I])... };
+        for (u32 i = 0; i < count; ++i) {
+            if ((Passes(I, added[I][i], changed[I][i]) && ...)) {
+                (Stamp<I>(changed[I][i]), ...);
+                Invoke(func, entities[i], std::get<I>(data)[i]...);
+            }
+        }
+    }
+
+    template<usize... I>
+    bool PassesRow(const Archetype& archetype, usize row, std::index_sequence<I...>) const {
+        auto passes = [&](usize component, ComponentTypeId type) {
+            const i32 column = archetype.GetColumnIndex(type);
+            return Passes(component, archetype.GetAddedTick(row, column), archetype.GetChangedTick(row, column));
+        };
+        return (passes(I, ComponentRegistry::GetTypeId<std::remove_const_t<Ts>>()) && ...);
+    }
+
+    // Index of the smallest included storage, NO_LEAD if any is missing
+    usize FindLead() const {
+        usize lead = NO_LEAD;
+        usize leadSize = ~usize(0);
+        usize index = 0;
+        bool missing = false;
+        auto consider = [&](const auto* storage) {
+            if (!storage) {
+                missing = true;
+            } else if (storage->Size() < leadSize) {
+                leadSize = storage->Size();
+                lead = index;
+            }
+            ++index;
+        };
+        std::apply([&](const auto*... storages) { (consider(storages), ...); }, m_Storages);
+        return missing ? NO_LEAD : lead;
+    }
+
+    template<usize... I>
+    usize LeadSize(usize lead, std::index_sequence<I...>) const {
+        usize size = 0;
+        ((I == lead ? (size = std::get<I>(m_Storages)->Size(), 0) : 0), ...);
+        return size;
+    }
+
+    template<typename Func, usize... I>
+    void DispatchLead(Func& func, usize lead, usize begin, usize end, std::index_sequence<I...> sequence) const {
+        ((I == lead ? (EachWithLead<I>(func, begin, end, sequence), 0) : 0), ...);
+    }
+
+    // Dense index of component I for the entity at dense position leadIndex
+    // of storage Lead, or NONE
+    template<usize I, usize Lead>
+    ENJIN_FORCE_INLINE u32 Fetch(Entity entity, usize leadIndex) const {
+        if constexpr (I == Lead) {
+            return static_cast<u32>(leadIndex);
+        } else {
+            return std::get<I>(m_Storages)->GetIndex(entity);
+        }
+    }
+
+    template<usize I>
+    ENJIN_FORCE_INLINE bool PassesDense(u32 index) const {
+        const auto* storage = std::get<I>(m_Storages);
+        return Passes(I, storage->GetAddedTicks()[index], storage->GetChangedTicks()[index]);
+    }
+
+    // Visits dense positions [begin, end) of storage Lead
+    template<usize Lead, typename Func, usize... I>
+    void EachWithLead(Func& func, usize begin, usize end, std::index_sequence<I...>) const {
+        constexpr u32 NONE = ~0u;
+        const Entity* entities = std::get<Lead>(m_Storages)->GetEntities().data();
+        for (usize i = begin; i < end; ++i) {
+            const Entity entity = entities[i];
+            const u32 indices[] = { Fetch<I, Lead>(entity, i)... };
+            if (((indices[I] != NONE) && ...) && !IsExcluded(entity) && (!m_Filtered || (PassesDense<I>(indices[I]) && ...))) {
+                (StampDense<I>(indices[I]), ...);
+                Invoke(func, entity, std::get<I>(m_Storages)->GetComponents()[indices[I]]...);
+            }
+        }
+    }
+
+    template<usize I>
+    ENJIN_FORCE_INLINE void StampDense(u32 index) const {
+        if constexpr (!std::is_const_v<TypeAt<I>>) {
+            std::get<I>(m_Storages)->GetChangedTicks()[index] = m_Tick;
+        }
+    }
+
+    template<usize... I>
+    bool HasAll(Entity entity, std::index_sequence<I...>) const {
+        return (std::get<I>(m_Storages)->Has(entity) && ...);
+    }
+
+    template<usize... I>
+    bool PassesEntity(Entity entity, std::index_sequence<I...>) const {
+        return (PassesDense<I>(std::get<I>(m_Storages)->GetIndex(entity)) && ...);
+    }
+
+    bool IsExcluded(Entity entity) const {
+        return std::apply([entity](auto*... storages) {
+            return ((storages && storages->Has(entity)) || ...);
+        }, m_Excludes);
+    }
+
+    std::tuple<StoragePtr<Ts>...> m_Storages{};
+    ExcludePtrs m_Excludes{};
+    const ArchetypeStorage* m_Archetypes = nullptr;
+
+    ChangeTick m_Tick = 0; // Stamped on non-const components the view hands out
+    std::array<TickFilter, sizeof...(Ts)> m_Filters{};
+    std::array<ChangeTick, sizeof...(Ts)> m_Since{};
+    bool m_Filtered = false;
+};
+
+} // namespace ECS
+} // namespace Enjin
@@ -4,8 +4,19 @@
 #include "Enjin/ECS/Entity.h"
 #include "Enjin/ECS/Component.h"
 #include "Enjin/ECS/System.h"
-#include <unordered_map>
+#include "Enjin/ECS/Archetype.h"
+#include "Enjin/ECS/View.h"
+#include "Enjin/ECS/Group.h"
+#include "Enjin/ECS/Snapshot.h"
+#include "Enjin/Core/Assert.h"
+#include "Enjin/Memory/MemoryTracker.h"
+#include "Enjin/Memory/MemoryResource.h"
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
 
 /**
  * @file World.h
@@ -17,17 +28,61 @@
 namespace Enjin {
 namespace ECS {
 
+class CommandBuffer;
+class Prefab;
+struct TransformComponent;
+
+// How a World lays out component data
+enum class StorageMode : u8 {
+    SparseSet, // One ComponentStorage per type; cheap add/remove, per-type iteration
+    Archetype  // Entities grouped by component set in 16 KB SoA chunks; fastest multi-component iteration
+};
+
 /**
  * @brief The World class manages the entire ECS state
  * 
  * It acts as the container for all entities, components, and systems.
  * It provides methods to create/destroy entities and access components.
+ *
+ * Component storages and their contents are allocated from the memory
+ * resource given at construction, so a world built on an arena-backed
+ * AllocatorResource is released with the arena.
+ *
+ * The storage mode is fixed at construction. In Archetype mode, component
+ * pointers are invalidated by any Add/RemoveComponent or DestroyEntity, since
+ * those move rows between chunks.
+ *
+ * Structural changes (create/destroy, add/remove) apply immediately and are
+ * not thread-safe. During iteration or from concurrently running systems,
+ * record them into GetCommandBuffer() instead; Update() plays them back
+ * after the systems ran.
+ *
+ * Every component remembers the change tick at which it was added and last
+ * written: AddComponent, the non-const GetComponent and non-const view
+ * components stamp the current tick, which advances before each system runs.
+ * Views filter on it with Changed<T>() / Added<T>().
  */
 class ENJIN_API World {
 public:
-    World();
+    explicit World(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    explicit World(StorageMode mode, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
     ~World();
 
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    std::pmr::memory_resource* GetMemoryResource() const { return m_Resource; }
+    StorageMode GetStorageMode() const { return m_StorageMode; }
+
+    /**
+     * @brief Tick stamped on components written now
+     *
+     * Advanced before every system update and after the last one, so writes
+     * made inside a system are newer than that system's previous run and
+     * writes made between frames are newer than every system's last run.
+     */
+    ChangeTick GetChangeTick() const { return m_ChangeTick.load(std::memory_order_relaxed); }
+
     /**
      * @brief Create a new entity
      * @return The created Entity handle
@@ -41,43 +96,161 @@ public:
     void DestroyEntity(Entity entity);
 
     /**
-     * @brief Check if an entity is valid
+     * @brief Create one entity per element of entities
+     * @param entities Receives the new handles
+     */
+    void CreateEntities(std::span<Entity> entities);
+
+    /**
+     * @brief Destroy several entities and all their components
+     *
+     * Systems are notified entity by entity, then each component storage
+     * involved drops all of them in one pass. Destroyed and repeated handles
+     * are skipped.
+     */
+    void DestroyEntities(std::span<const Entity> entities);
+
+    /**
+     * @brief Create one entity per element of entities, each a copy of prefab
+     *
+     * Every prefab component is copied into its storage as one run over all
+     * the new entities; in Archetype mode they go straight into the
+     * archetype for the prefab's component set. Systems are notified once
+     * per entity, after all of its components are in place.
+     *
+     * Include Enjin/ECS/Prefab.h to build prefabs.
+     *
+     * @param entities Receives the new handles
+     * @param transforms Empty, or one TransformComponent per instance, used
+     *                   instead of the prefab's (which it needn't have)
+     */
+    void Instantiate(const Prefab& prefab, std::span<Entity> entities, std::span<const TransformComponent> transforms = {});
+
+    // Instantiate() of a single entity
+    Entity Instantiate(const Prefab& prefab);
+
+    /**
+     * @brief Check if an entity is alive
      * @param entity The entity to check
-     * @return true if valid, false otherwise
+     * @return false for INVALID_ENTITY and for handles whose entity was destroyed
      */
     bool IsValid(Entity entity) const;
 
+    usize GetEntityCount() const { return m_EntityManager.GetAliveCount(); }
+
     // Component management
     template<typename T>
     T& AddComponent(Entity entity, const T& component = T{}) {
+        ENJIN_ASSERT(IsValid(entity), "AddComponent on a destroyed entity");
+        MemoryTagScope memoryTag(MemoryTag::ECS);
+        const ChangeTick tick = GetChangeTick();
+        if (m_StorageMode == StorageMode::Archetype) {
+            const ComponentTypeInfo& info = ComponentRegistry::GetTypeInfo<T>();
+            void* slot = m_Archetypes.Add(entity, info, tick);
+            if (!slot) {
+                T& existing = *static_cast<T*>(m_Archetypes.GetMutable(entity, info.id, tick));
+                existing = component;
+                return existing;
+            }
+            T& comp = *new (slot) T(component);
+            OnComponentAdded(entity, info.id);
+            return comp;
+        }
         auto storage = GetOrCreateStorage<T>();
-        if (storage->Has(entity)) {
-            *storage->Get(entity) = component;
-            return *storage->Get(entity);
+        if (T* existing = storage->GetMutable(entity, tick)) {
+            *existing = component;
+            return *existing;
         }
-        T& comp = storage->Add(entity);
+        T& comp = storage->Add(entity, tick);
         comp = component;
-        m_SystemManager->OnEntityAdded(entity);
+        OnComponentAdded(entity, ComponentRegistry::GetTypeId<T>());
         return comp;
     }
 
+    /**
+     * @brief AddComponent() for many entities: components[i] goes to entities[i]
+     *
+     * In SparseSet mode the storage grows once and new components are copied
+     * in as whole runs (memcpy for trivially copyable types); systems are
+     * notified after all of them are in place.
+     *
+     * @example
+     * std::vector<Entity> particles(4096);
+     * world.CreateEntities(particles);
+     * world.AddComponents<ParticleComponent>(particles, initialStates);
+     */
+    template<typename T>
+    void AddComponents(std::span<const Entity> entities, std::span<const T> components) {
+        ENJIN_ASSERT(entities.size() == components.size(), "AddComponents needs one component per entity");
+        MemoryTagScope memoryTag(MemoryTag::ECS);
+        const ChangeTick tick = GetChangeTick();
+        if (m_StorageMode == StorageMode::Archetype) {
+            const ComponentTypeInfo& info = ComponentRegistry::GetTypeInfo<T>();
+            for (usize i = 0; i < entities.size(); ++i) {
+                if (void* slot = m_Archetypes.Add(entities[i], info, tick)) {
+                    new (slot) T(components[i]);
+                } else {
+                    *static_cast<T*>(m_Archetypes.GetMutable(entities[i], info.id, tick)) = components[i];
+                }
+            }
+        } else {
+            GetOrCreateStorage<T>()->Add(entities, components, tick);
+        }
+        OnComponentsAdded(entities, ComponentRegistry::GetTypeId<T>());
+    }
+
+    // AddComponents() with the same component for every entity
+    template<typename T>
+    void AddComponents(std::span<const Entity> entities, const T& component = T{}) {
+        MemoryTagScope memoryTag(MemoryTag::ECS);
+        const ChangeTick tick = GetChangeTick();
+        if (m_StorageMode == StorageMode::Archetype) {
+            const ComponentTypeInfo& info = ComponentRegistry::GetTypeInfo<T>();
+            for (Entity entity : entities) {
+                if (void* slot = m_Archetypes.Add(entity, info, tick)) {
+                    new (slot) T(component);
+                } else {
+                    *static_cast<T*>(m_Archetypes.GetMutable(entity, info.id, tick)) = component;
+                }
+            }
+        } else {
+            GetOrCreateStorage<T>()->Add(entities, component, tick);
+        }
+        OnComponentsAdded(entities, ComponentRegistry::GetTypeId<T>());
+    }
+
     template<typename T>
     void RemoveComponent(Entity entity) {
-        auto storage = GetOrCreateStorage<T>();
-        if (storage->Has(entity)) {
+        if (m_StorageMode == StorageMode::Archetype) {
+            const ComponentTypeId typeId = ComponentRegistry::GetTypeId<T>();
+            if (m_Archetypes.Has(entity, typeId)) {
+                OnComponentRemoving(entity, typeId);
+                m_Archetypes.Remove(entity, typeId);
+            }
+            return;
+        }
+        auto storage = FindStorage<T>();
+        if (storage && storage->Has(entity)) {
+            OnComponentRemoving(entity, ComponentRegistry::GetTypeId<T>());
             storage->Remove(entity);
-            m_SystemManager->OnEntityRemoved(entity);
         }
     }
 
+    // Stamps the component as changed; use the const overload to only read
     template<typename T>
     T* GetComponent(Entity entity) {
-        auto storage = GetOrCreateStorage<T>();
-        return storage->Get(entity);
+        if (m_StorageMode == StorageMode::Archetype) {
+            return static_cast<T*>(m_Archetypes.GetMutable(entity, ComponentRegistry::GetTypeId<T>(), GetChangeTick()));
+        }
+        auto storage = FindStorage<T>();
+        return storage ? storage->GetMutable(entity, GetChangeTick()) : nullptr;
     }
 
     template<typename T>
     const T* GetComponent(Entity entity) const {
+        if (m_StorageMode == StorageMode::Archetype) {
+            return static_cast<const T*>(m_Archetypes.Get(entity, ComponentRegistry::GetTypeId<T>()));
+        }
         auto storage = GetStorage<T>();
         if (!storage) {
             return nullptr;
@@ -87,6 +260,9 @@ public:
 
     template<typename T>
     bool HasComponent(Entity entity) const {
+        if (m_StorageMode == StorageMode::Archetype) {
+            return m_Archetypes.Has(entity, ComponentRegistry::GetTypeId<T>());
+        }
         auto storage = GetStorage<T>();
         if (!storage) {
             return false;
@@ -94,6 +270,131 @@ public:
         return storage->Has(entity);
     }
 
+    // Every component type the entity has; empty for destroyed entities
+    const ComponentMask& GetComponentMask(Entity entity) const;
+
+    /**
+     * @brief Query entities that have all of Ts and none of the excluded types
+     *
+     * @example
+     * world.View<TransformComponent, const MeshComponent>().Each(
+     *     [](Entity entity, TransformComponent& transform, const MeshComponent& mesh) { ... });
+     */
+    template<typename... Ts, typename... Xs>
+    ComponentView<TypeList<Ts...>, TypeList<Xs...>> View(ExcludeList<Xs...> = {}) {
+        if (m_StorageMode == StorageMode::Archetype) {
+            return ComponentView<TypeList<Ts...>, TypeList<Xs...>>(&m_Archetypes, GetChangeTick());
+        }
+        return { std::make_tuple(FindStorage<std::remove_const_t<Ts>>()...),
+                 std::make_tuple(GetStorage<std::remove_const_t<Xs>>()...), GetChangeTick() };
+    }
+
+    // Read-only query; only const component access is allowed
+    template<typename... Ts, typename... Xs>
+    ComponentView<TypeList<Ts...>, TypeList<Xs...>> View(ExcludeList<Xs...> = {}) const {
+        static_assert((std::is_const_v<Ts> && ...), "A const World only provides views of const components");
+        if (m_StorageMode == StorageMode::Archetype) {
+            return ComponentView<TypeList<Ts...>, TypeList<Xs...>>(&m_Archetypes, GetChangeTick());
+        }
+        return { std::make_tuple(GetStorage<std::remove_const_t<Ts>>()...),
+                 std::make_tuple(GetStorage<std::remove_const_t<Xs>>()...), GetChangeTick() };
+    }
+
+    // Shorthand for View<Ts...>().Each(func)
+    template<typename... Ts, typename Func>
+    void Each(Func&& func) {
+        View<Ts...>().Each(std::forward<Func>(func));
+    }
+
+    /**
+     * @brief Query entities that have all of Ts, kept packed for iteration
+     *
+     * The first call for a set of types creates an owning group (see
+     * ComponentGroup): it reorders the Ts storages so that matching entities
+     * come first, and from then on every add, remove and destroy keeps them
+     * there with one swap per owned storage. Later calls just look it up.
+     * Create groups at setup, or from an exclusive system, since the first
+     * call moves components around.
+     *
+     * Falls back to an unpacked view in Archetype mode, and (with an error)
+     * when one of Ts is already owned by a group of different types.
+     */
+    template<typename... Ts>
+    ComponentGroup<Ts...> Group() {
+        if (m_StorageMode == StorageMode::Archetype) {
+            return ComponentGroup<Ts...>(View<Ts...>());
+        }
+        (GetOrCreateStorage<std::remove_const_t<Ts>>(), ...);
+        const GroupData* group = AcquireGroup(ComponentMask::Of<Ts...>());
+        if (!group) {
+            return ComponentGroup<Ts...>(View<Ts...>());
+        }
+        return { std::make_tuple(FindStorage<std::remove_const_t<Ts>>()...), &group->size, GetChangeTick() };
+    }
+
+    /**
+     * @brief Write the entity table and the Ts columns to a binary snapshot
+     *
+     * Each column is written as one contiguous array of raw component bytes
+     * (per chunk in Archetype mode), tagged with the type's hash. Change
+     * ticks are not saved. See Snapshot.h for the format.
+     *
+     * @example
+     * world.SaveSnapshot<TransformComponent, HierarchyComponent, Velocity>("level.snap");
+     */
+    template<typename... Ts>
+    bool SaveSnapshot(const std::string& path) const {
+        static_assert((std::is_trivially_copyable_v<Ts> && ...), "Snapshots store raw bytes; components must be trivially copyable");
+        SnapshotWriter writer(m_Resource);
+        if (!writer.Open(path, m_EntityManager.GetGenerations(), m_EntityManager.GetFreeIndices())) {
+            return false;
+        }
+        (WriteSnapshotTable<Ts>(writer), ...);
+        return writer.Close();
+    }
+
+    /**
+     * @brief Replace the world's contents with a snapshot
+     *
+     * The file is memory-mapped and validated; then every entity handle is
+     * restored exactly and each of the Ts columns found in the file is bulk
+     * copied into its storage (AddComponents), with no per-entity parsing.
+     * Systems are told about the removal of the old entities and the arrival
+     * of the new ones, which all count as added at the current change tick.
+     * On failure the world is left untouched.
+     */
+    template<typename... Ts>
+    bool LoadSnapshot(const std::string& path) {
+        static_assert((std::is_trivially_copyable_v<Ts> && ...), "Snapshots store raw bytes; components must be trivially copyable");
+        SnapshotReader reader;
+        if (!reader.Open(path)) {
+            return false;
+        }
+        RestoreEntities(reader);
+        (ReadSnapshotTable<Ts>(reader), ...);
+        return true;
+    }
+
+    // Archetype-mode storage, for chunk-level iteration (empty in SparseSet mode)
+    ArchetypeStorage& GetArchetypeStorage() { return m_Archetypes; }
+    const ArchetypeStorage& GetArchetypeStorage() const { return m_Archetypes; }
+
+    /**
+     * @brief The calling thread's command buffer for this world
+     *
+     * Include Enjin/ECS/CommandBuffer.h to record into it.
+     *
+     * @threadsafe Yes; each thread gets its own buffer
+     */
+    CommandBuffer& GetCommandBuffer();
+
+    /**
+     * @brief Apply every thread's recorded commands in one sorted pass
+     *
+     * A sync point: no thread may be recording while this runs.
+     */
+    void FlushCommandBuffers();
+
     // System management
     template<typename T, typename... Args>
     T* RegisterSystem(Args&&... args) {
@@ -102,6 +403,9 @@ public:
 
     /**
      * @brief Update the world state
+     *
+     * Runs the systems, then flushes the command buffers.
+     *
      * @param deltaTime Time elapsed since last frame in seconds
      */
     void Update(f32 deltaTime);
@@ -112,47 +416,164 @@ public:
     void Clear(); // Clear all entities and components
 
 private:
+    friend class CommandBuffer; // Applies recorded commands straight to the storages
+    friend class Prefab;        // Appends prefab components straight to the storages
+
     // Type-erased component storage wrapper
     struct StorageBase {
         virtual ~StorageBase() = default;
         virtual void Remove(Entity entity) = 0;
+        virtual void Remove(std::span<const Entity> entities) = 0;
+        virtual u32 GetIndex(Entity entity) const = 0;
+        virtual void Swap(u32 a, u32 b) = 0;
+        virtual usize Size() const = 0;
+        virtual Entity GetEntity(u32 index) const = 0;
+        virtual void Destroy(std::pmr::polymorphic_allocator<> allocator) = 0; // Frees with the exact type's size
     };
 
     template<typename T>
     struct StorageWrapper : public StorageBase {
         ComponentStorage<T> storage;
-        
+
+        explicit StorageWrapper(std::pmr::memory_resource* resource) : storage(resource) {}
+
         void Remove(Entity entity) override {
             storage.Remove(entity);
         }
+
+        void Remove(std::span<const Entity> entities) override {
+            storage.Remove(entities);
+        }
+
+        u32 GetIndex(Entity entity) const override {
+            return storage.GetIndex(entity);
+        }
+
+        void Swap(u32 a, u32 b) override {
+            storage.Swap(a, b);
+        }
+
+        usize Size() const override {
+            return storage.Size();
+        }
+
+        Entity GetEntity(u32 index) const override {
+            return storage.GetEntities()[index];
+        }
+
+        void Destroy(std::pmr::polymorphic_allocator<> allocator) override {
+            allocator.delete_object(this);
+        }
+    };
+
+    // An owning group: its entities fill dense positions [0, size) of the
+    // storage of every type in owned. Allocated once, so views of it can
+    // point at size.
+    struct GroupData {
+        ComponentMask owned;
+        usize size = 0;
     };
 
+    // The group owning exactly these types, created if no other group owns
+    // any of them; nullptr on a conflict
+    GroupData* AcquireGroup(const ComponentMask& owned);
+
+    // Move the entity to the end of the group's range / just past it; the
+    // entity has all of the group's components
+    void PackIntoGroup(GroupData& group, Entity entity);
+    void UnpackFromGroup(GroupData& group, Entity entity);
+
+    // The group owning typeId's storage, if any
+    GroupData* FindGroup(ComponentTypeId typeId) const {
+        return typeId < m_GroupByType.size() ? m_GroupByType[typeId] : nullptr;
+    }
+
+    // Unpacks the entity from every group it is in, before it loses mask
+    void LeaveGroups(Entity entity, const ComponentMask& mask);
+
+    // Keep the entity's mask current and notify the systems whose signature
+    // it starts or stops matching; removal notifies before the data goes
+    void OnComponentAdded(Entity entity, ComponentTypeId typeId);
+    void OnComponentRemoving(Entity entity, ComponentTypeId typeId);
+    void OnComponentsAdded(std::span<const Entity> entities, ComponentTypeId typeId); // Skips those that had it
+    void OnEntitiesSpawned(std::span<const Entity> entities, const ComponentMask& mask); // They had no components
+
+    // Notifies systems of every current entity's removal, clears the world
+    // and adopts the snapshot's entity table
+    void RestoreEntities(const SnapshotReader& reader);
+
+    template<typename T>
+    void WriteSnapshotTable(SnapshotWriter& writer) const {
+        writer.BeginTable(ComponentRegistry::GetTypeHash<T>(), sizeof(T), alignof(T));
+        if (m_StorageMode == StorageMode::Archetype) {
+            m_Archetypes.ForEachChunk<const T>([&writer](u32 count, const Entity* entities, const T*) {
+                writer.WriteEntities(entities, count);
+            });
+            m_Archetypes.ForEachChunk<const T>([&writer](u32 count, const Entity*, const T* components) {
+                writer.WriteComponents(components, count);
+            });
+        } else if (const ComponentStorage<T>* storage = GetStorage<T>()) {
+            writer.WriteEntities(storage->GetEntities().data(), storage->Size());
+            writer.WriteComponents(storage->GetComponents().data(), storage->Size());
+        }
+        writer.EndTable();
+    }
+
+    template<typename T>
+    void ReadSnapshotTable(const SnapshotReader& reader) {
+        const SnapshotTable* table = reader.FindTable(ComponentRegistry::GetTypeHash<T>(), sizeof(T), alignof(T));
+        if (table && table->count > 0) {
+            const std::span<const T> components(static_cast<const T*>(reader.GetComponents(*table)), static_cast<usize>(table->count));
+            AddComponents<T>(reader.GetEntities(*table), components);
+        }
+    }
+
+    // Storage slot for a type id; nullptr until its first component is added
+    StorageBase* FindStorageBase(ComponentTypeId typeId) const {
+        return typeId < m_ComponentStorages.size() ? m_ComponentStorages[typeId] : nullptr;
+    }
+
     template<typename T>
     ComponentStorage<T>* GetOrCreateStorage() {
-        ComponentTypeId typeId = ComponentRegistry::GetTypeId<T>();
-        auto it = m_ComponentStorages.find(typeId);
-        if (it == m_ComponentStorages.end()) {
-            auto wrapper = std::make_unique<StorageWrapper<T>>();
-            ComponentStorage<T>* ptr = &wrapper->storage;
-            m_ComponentStorages[typeId] = std::move(wrapper);
-            return ptr;
+        const ComponentTypeId typeId = ComponentRegistry::GetTypeId<T>();
+        if (typeId >= m_ComponentStorages.size()) {
+            m_ComponentStorages.resize(static_cast<usize>(typeId) + 1, nullptr);
         }
-        return &static_cast<StorageWrapper<T>*>(it->second.get())->storage;
+        StorageBase*& slot = m_ComponentStorages[typeId];
+        if (!slot) {
+            std::pmr::polymorphic_allocator<> allocator(m_Resource);
+            slot = allocator.new_object<StorageWrapper<T>>(m_Resource);
+        }
+        return &static_cast<StorageWrapper<T>*>(slot)->storage;
+    }
+
+    template<typename T>
+    ComponentStorage<T>* FindStorage() {
+        StorageBase* base = FindStorageBase(ComponentRegistry::GetTypeId<T>());
+        return base ? &static_cast<StorageWrapper<T>*>(base)->storage : nullptr;
     }
 
     template<typename T>
     const ComponentStorage<T>* GetStorage() const {
-        ComponentTypeId typeId = ComponentRegistry::GetTypeId<T>();
-        auto it = m_ComponentStorages.find(typeId);
-        if (it == m_ComponentStorages.end()) {
-            return nullptr;
-        }
-        return &static_cast<const StorageWrapper<T>*>(it->second.get())->storage;
+        const StorageBase* base = FindStorageBase(ComponentRegistry::GetTypeId<T>());
+        return base ? &static_cast<const StorageWrapper<T>*>(base)->storage : nullptr;
     }
 
+    std::pmr::memory_resource* m_Resource;
+    StorageMode m_StorageMode = StorageMode::SparseSet;
+    std::atomic<ChangeTick> m_ChangeTick{1}; // Advanced by SystemManager; 0 means "never"
     EntityManager m_EntityManager;
     std::unique_ptr<SystemManager> m_SystemManager;
-    std::unordered_map<ComponentTypeId, std::unique_ptr<StorageBase>> m_ComponentStorages;
+    pmr::Vector<StorageBase*> m_ComponentStorages; // Indexed by ComponentTypeId
+    pmr::Vector<ComponentMask> m_ComponentMasks;   // Indexed by entity index
+    ArchetypeStorage m_Archetypes;
+    pmr::Vector<GroupData*> m_Groups;
+    pmr::Vector<GroupData*> m_GroupByType;         // Indexed by ComponentTypeId
+
+    // Per-thread command buffers, found through a thread_local cache keyed by m_Id
+    u64 m_Id;
+    std::mutex m_CommandBufferMutex;
+    pmr::Vector<std::pair<std::thread::id, CommandBuffer*>> m_CommandBuffers;
 };
 
 } // namespace ECS
@@ -3,8 +3,8 @@
 #include "Enjin/Platform/Platform.h"
 #include "Enjin/Math/Vector.h"
 #include "Enjin/Math/Matrix.h"
+#include "Enjin/Memory/MemoryResource.h"
 #include <memory>
-#include <vector>
 
 namespace Enjin {
 namespace Physics {
@@ -23,10 +23,11 @@ class Collider;
  * - Basic constraints
  * 
  * @note Designed to be simple and performant
+ * @note The body list allocates from the memory resource given at construction
  */
 class ENJIN_API PhysicsWorld {
 public:
-    PhysicsWorld();
+    explicit PhysicsWorld(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
     ~PhysicsWorld();
 
     /**
@@ -68,13 +69,13 @@ public:
     /**
      * @brief Get all rigid bodies
      */
-    const std::vector<std::shared_ptr<RigidBody>>& GetRigidBodies() const {
+    const pmr::Vector<std::shared_ptr<RigidBody>>& GetRigidBodies() const {
         return m_RigidBodies;
     }
 
 private:
     Math::Vector3 m_Gravity = Math::Vector3(0.0f, -9.81f, 0.0f);
-    std::vector<std::shared_ptr<RigidBody>> m_RigidBodies;
+    pmr::Vector<std::shared_ptr<RigidBody>> m_RigidBodies;
     
     void Integrate(f32 deltaTime);
     void DetectCollisions();
@@ -2,6 +2,7 @@
 
 #include "Enjin/Platform/Platform.h"
 #include "Enjin/Math/Vector.h"
+#include "Enjin/Memory/MemoryResource.h"
 #include <vulkan/vulkan.h>
 #include <string>
 #include <unordered_map>
@@ -100,9 +101,10 @@ private:
 
 // Material system - manages all materials
 // DESIGN: Data-driven, hot-reloadable, scriptable
+// The material table and name map allocate from the given memory resource.
 class ENJIN_API MaterialSystem {
 public:
-    MaterialSystem();
+    explicit MaterialSystem(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
     ~MaterialSystem();
 
     void Shutdown();
@@ -127,8 +129,8 @@ public:
     void ForEachMaterial(std::function<void(MaterialInstance*)> callback);
 
 private:
-    std::vector<std::unique_ptr<MaterialInstance>> m_Materials;
-    std::unordered_map<std::string, u32> m_MaterialNameMap;
+    pmr::Vector<std::unique_ptr<MaterialInstance>> m_Materials;
+    pmr::UnorderedMap<std::string, u32> m_MaterialNameMap;
     bool m_FileWatching = false;
     
     // File watcher would be implemented here
@@ -2,10 +2,10 @@
 
 #include "Enjin/Platform/Platform.h"
 #include "Enjin/Renderer/Vulkan/VulkanContext.h"
+#include "Enjin/Memory/MemoryResource.h"
 #include <vulkan/vulkan.h>
-#include <vector>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <memory>
 #include <functional>
 
@@ -48,7 +48,7 @@ struct ResourceState {
 // Render pass node in graph
 class RenderPassNode {
 public:
-    RenderPassNode(const std::string& name);
+    RenderPassNode(std::string_view name, std::pmr::memory_resource* resource);
     
     void AddColorInput(ResourceHandle handle);
     void AddColorOutput(ResourceHandle handle);
@@ -61,13 +61,13 @@ public:
     
     void SetExecuteCallback(std::function<void(VkCommandBuffer)> callback);
     
-    const std::string& GetName() const { return m_Name; }
-    const std::vector<ResourceHandle>& GetInputs() const { return m_Inputs; }
-    const std::vector<ResourceHandle>& GetOutputs() const { return m_Outputs; }
-    const std::vector<ResourceHandle>& GetSampledImages() const { return m_SampledImages; }
-    const std::vector<ResourceHandle>& GetStorageImages() const { return m_StorageImages; }
-    const std::vector<ResourceHandle>& GetUniformBuffers() const { return m_UniformBuffers; }
-    const std::vector<ResourceHandle>& GetStorageBuffers() const { return m_StorageBuffers; }
+    const pmr::String& GetName() const { return m_Name; }
+    const pmr::Vector<ResourceHandle>& GetInputs() const { return m_Inputs; }
+    const pmr::Vector<ResourceHandle>& GetOutputs() const { return m_Outputs; }
+    const pmr::Vector<ResourceHandle>& GetSampledImages() const { return m_SampledImages; }
+    const pmr::Vector<ResourceHandle>& GetStorageImages() const { return m_StorageImages; }
+    const pmr::Vector<ResourceHandle>& GetUniformBuffers() const { return m_UniformBuffers; }
+    const pmr::Vector<ResourceHandle>& GetStorageBuffers() const { return m_StorageBuffers; }
     
     void Execute(VkCommandBuffer cmd) const;
     
@@ -75,21 +75,21 @@ public:
     void SetOrder(u32 order) { m_Order = order; }
 
 private:
-    std::string m_Name;
-    std::vector<ResourceHandle> m_Inputs;
-    std::vector<ResourceHandle> m_Outputs;
-    std::vector<ResourceHandle> m_SampledImages;
-    std::vector<ResourceHandle> m_StorageImages;
-    std::vector<ResourceHandle> m_UniformBuffers;
-    std::vector<ResourceHandle> m_StorageBuffers;
-    std::function<void(VkCommandBuffer)> m_ExecuteCallback;
+    pmr::String m_Name;
+    pmr::Vector<ResourceHandle> m_Inputs;
+    pmr::Vector<ResourceHandle> m_Outputs;
+    pmr::Vector<ResourceHandle> m_SampledImages;
+    pmr::Vector<ResourceHandle> m_StorageImages;
+    pmr::Vector<ResourceHandle> m_UniformBuffers;
+    pmr::Vector<ResourceHandle> m_StorageBuffers;
+    std::function<void(VkCommandBuffer)> m_ExecuteCallback; // Captures stay on the global heap
     u32 m_Order = 0;
 };
 
 // Resource node in graph
 class ResourceNode {
 public:
-    ResourceNode(const std::string& name, ResourceType type);
+    ResourceNode(std::string_view name, ResourceType type, std::pmr::memory_resource* resource);
     
     void SetImage(VkImage image, VkFormat format, u32 width, u32 height);
     void SetBuffer(VkBuffer buffer, VkDeviceSize size);
@@ -97,7 +97,7 @@ public:
     ResourceHandle GetHandle() const { return m_Handle; }
     void SetHandle(ResourceHandle handle) { m_Handle = handle; }
     
-    const std::string& GetName() const { return m_Name; }
+    const pmr::String& GetName() const { return m_Name; }
     ResourceType GetType() const { return m_Type; }
     
     VkImage GetImage() const { return m_Image; }
@@ -111,7 +111,7 @@ public:
     void SetCurrentState(const ResourceState& state) { m_CurrentState = state; }
 
 private:
-    std::string m_Name;
+    pmr::String m_Name;
     ResourceType m_Type;
     ResourceHandle m_Handle = INVALID_RESOURCE_HANDLE;
     
@@ -125,12 +125,17 @@ private:
     ResourceState m_CurrentState;
 };
 
-// Render graph - automatic pass ordering and resource management
+// Render graph - automatic pass ordering and resource management.
+// Nodes, names and lists all allocate from the memory resource given at
+// construction, so a per-frame graph can live in frame scratch memory.
 class ENJIN_API RenderGraph {
 public:
-    RenderGraph(VulkanContext* context);
+    RenderGraph(VulkanContext* context, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
     ~RenderGraph();
 
+    RenderGraph(const RenderGraph&) = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+
     // Add resource
     ResourceHandle AddResource(const std::string& name, ResourceType type);
     ResourceNode* GetResource(ResourceHandle handle);
@@ -151,6 +156,12 @@ public:
     ResourceHandle GetResourceHandle(const std::string& name) const;
 
 private:
+    // Heterogeneous lookup so GetResourceHandle doesn't build a key string
+    struct NameHash {
+        using is_transparent = void;
+        usize operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+    };
+
     // Dependency resolution
     void ResolveDependencies();
     void TopologicalSort();
@@ -164,10 +175,11 @@ private:
     ResourceState GetRequiredState(ResourceUsage usage, bool isInput);
     
     VulkanContext* m_Context = nullptr;
-    std::vector<std::unique_ptr<ResourceNode>> m_Resources;
-    std::vector<std::unique_ptr<RenderPassNode>> m_Passes;
-    std::unordered_map<std::string, ResourceHandle> m_ResourceNameMap;
-    std::vector<RenderPassNode*> m_OrderedPasses;
+    std::pmr::polymorphic_allocator<> m_Allocator;
+    pmr::Vector<ResourceNode*> m_Resources;   // Owned, created with m_Allocator
+    pmr::Vector<RenderPassNode*> m_Passes;    // Owned, created with m_Allocator
+    pmr::UnorderedMap<pmr::String, ResourceHandle, NameHash, std::equal_to<>> m_ResourceNameMap;
+    pmr::Vector<RenderPassNode*> m_OrderedPasses;
     bool m_Built = false;
 };
 
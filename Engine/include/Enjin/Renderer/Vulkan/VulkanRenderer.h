@@ -2,6 +2,7 @@
 
 #include "Enjin/Platform/Platform.h"
 #include "Enjin/Platform/Window.h"
+#include "Enjin/Memory/FrameAllocator.h"
 #include "Enjin/Renderer/Vulkan/VulkanContext.h"
 #include "Enjin/Renderer/Vulkan/VulkanSwapchain.h"
 #include <vulkan/vulkan.h>
@@ -25,6 +26,9 @@ namespace Renderer {
  */
 class ENJIN_API VulkanRenderer {
 public:
+    // Shared with the Application frame allocator so scratch memory outlives the GPU frame
+    static constexpr u32 MAX_FRAMES_IN_FLIGHT = DEFAULT_FRAMES_IN_FLIGHT;
+
     VulkanRenderer();
     ~VulkanRenderer();
 
@@ -87,7 +91,6 @@ private:
 
     u32 m_CurrentFrame = 0;
     u32 m_CurrentImageIndex = 0;
-    static constexpr u32 MAX_FRAMES_IN_FLIGHT = 2;
 
     bool m_IsFrameStarted = false;
 };
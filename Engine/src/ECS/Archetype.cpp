@@ -0,0 +1,373 @@
+#include "Enjin/ECS/Archetype.h"
+#include "Enjin/Core/Assert.h"
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @file Archetype.cpp
+ * @brief Implementation of Archetype and ArchetypeStorage
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+namespace ECS {
+
+namespace {
+
+usize AlignUp(usize value, usize alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+void Relocate(const ComponentTypeInfo& info, void* dst, void* src) {
+    if (info.relocate) {
+        info.relocate(dst, src);
+    } else {
+        std::memcpy(dst, src, info.size);
+    }
+}
+
+void Destroy(const ComponentTypeInfo& info, void* ptr) {
+    if (info.destroy) {
+        info.destroy(ptr);
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Archetype
+// ============================================================================
+
+Archetype::Archetype(std::span<const ComponentTypeInfo* const> types, std::pmr::memory_resource* resource)
+    : m_Resource(resource)
+    , m_Columns(resource)
+    , m_ColumnByType(resource)
+    , m_Chunks(resource)
+    , m_AddEdges(resource)
+    , m_RemoveEdges(resource) {
+    ComponentTypeId maxType = 0;
+    usize rowBytes = sizeof(Entity);
+    for (const ComponentTypeInfo* info : types) {
+        m_Columns.push_back({ info, 0, 0, 0 });
+        maxType = std::max(maxType, info->id);
+        rowBytes += info->size + 2 * sizeof(ChangeTick);
+    }
+
+    m_ColumnByType.assign(static_cast<usize>(maxType) + 1, -1);
+    for (usize i = 0; i < m_Columns.size(); ++i) {
+        m_ColumnByType[m_Columns[i].info->id] = static_cast<i32>(i);
+    }
+
+    // Lay out the columns for a given capacity; returns the bytes needed
+    auto layout = [this](usize capacity) {
+        usize offset = capacity * sizeof(Entity);
+        for (Column& column : m_Columns) {
+            offset = AlignUp(offset, column.info->alignment);
+            column.offset = static_cast<u32>(offset);
+            offset += capacity * column.info->size;
+        }
+        offset = AlignUp(offset, alignof(ChangeTick));
+        for (Column& column : m_Columns) {
+            column.addedOffset = static_cast<u32>(offset);
+            column.changedOffset = static_cast<u32>(offset + capacity * sizeof(ChangeTick));
+            offset += 2 * capacity * sizeof(ChangeTick);
+        }
+        return offset;
+    };
+
+    // Alignment padding can push the naive capacity over the chunk size
+    usize capacity = std::max<usize>(ARCHETYPE_CHUNK_SIZE / rowBytes, 1);
+    while (capacity > 1 && layout(capacity) > ARCHETYPE_CHUNK_SIZE) {
+        --capacity;
+    }
+    m_ChunkBytes = std::max(layout(capacity), ARCHETYPE_CHUNK_SIZE); // Oversized rows get one per chunk
+    m_ChunkCapacity = static_cast<u32>(capacity);
+}
+
+Archetype::~Archetype() {
+    for (usize row = 0; row < m_EntityCount; ++row) {
+        DestroyRow(row);
+    }
+    for (u8* chunk : m_Chunks) {
+        m_Resource->deallocate(chunk, m_ChunkBytes, CACHE_LINE_SIZE);
+    }
+}
+
+usize Archetype::PushRow(Entity entity) {
+    const usize row = m_EntityCount;
+    if (row == m_Chunks.size() * m_ChunkCapacity) {
+        m_Chunks.push_back(static_cast<u8*>(m_Resource->allocate(m_ChunkBytes, CACHE_LINE_SIZE)));
+    }
+    GetEntities(row / m_ChunkCapacity)[row % m_ChunkCapacity] = entity;
+    ++m_EntityCount;
+    return row;
+}
+
+Entity Archetype::RemoveRow(usize row) {
+    ENJIN_ASSERT(row < m_EntityCount, "Archetype row out of range");
+    const usize last = m_EntityCount - 1;
+    Entity moved = INVALID_ENTITY;
+
+    if (row != last) {
+        for (i32 column = 0; column < static_cast<i32>(m_Columns.size()); ++column) {
+            Relocate(*m_Columns[column].info, GetComponent(row, column), GetComponent(last, column));
+            SetTicks(row, column, GetAddedTick(last, column), GetChangedTick(last, column));
+        }
+        moved = GetEntity(last);
+        GetEntities(row / m_ChunkCapacity)[row % m_ChunkCapacity] = moved;
+    }
+
+    --m_EntityCount;
+    if (m_EntityCount <= (m_Chunks.size() - 1) * m_ChunkCapacity) {
+        m_Resource->deallocate(m_Chunks.back(), m_ChunkBytes, CACHE_LINE_SIZE);
+        m_Chunks.pop_back();
+    }
+    return moved;
+}
+
+void Archetype::DestroyRow(usize row) {
+    for (i32 column = 0; column < static_cast<i32>(m_Columns.size()); ++column) {
+        Destroy(*m_Columns[column].info, GetComponent(row, column));
+    }
+}
+
+// ============================================================================
+// ArchetypeStorage
+// ============================================================================
+
+ArchetypeStorage::ArchetypeStorage(std::pmr::memory_resource* resource)
+    : m_Resource(resource)
+    , m_Locations(resource)
+    , m_Archetypes(resource) {
+}
+
+ArchetypeStorage::~ArchetypeStorage() {
+    Clear();
+}
+
+const EntityLocation* ArchetypeStorage::FindLocation(Entity entity) const {
+    const u32 index = GetEntityIndex(entity);
+    if (index >= m_Locations.size()) {
+        return nullptr;
+    }
+    const EntityLocation& location = m_Locations[index];
+    // Stale handles must not reach the row of an entity that reused the index
+    if (location.archetype && location.archetype->GetEntity(location.row) != entity) {
+        return nullptr;
+    }
+    return &location;
+}
+
+EntityLocation* ArchetypeStorage::FindLocation(Entity entity) {
+    return const_cast<EntityLocation*>(static_cast<const ArchetypeStorage*>(this)->FindLocation(entity));
+}
+
+Archetype* ArchetypeStorage::GetArchetype(Entity entity) const {
+    const EntityLocation* location = FindLocation(entity);
+    return location ? location->archetype : nullptr;
+}
+
+void* ArchetypeStorage::Add(Entity entity, const ComponentTypeInfo& info, ChangeTick tick) {
+    const u32 index = GetEntityIndex(entity);
+    if (index >= m_Locations.size()) {
+        m_Locations.resize(static_cast<usize>(index) + 1);
+    }
+    EntityLocation* location = FindLocation(entity);
+    ENJIN_ASSERT(location, "Adding a component through a stale entity handle");
+    if (!location) {
+        return nullptr;
+    }
+    if (location->archetype && location->archetype->Has(info.id)) {
+        return nullptr;
+    }
+
+    Archetype* target = GetAddTarget(location->archetype, info);
+    MoveEntity(entity, *location, target);
+    const i32 column = target->GetColumnIndex(info.id);
+    target->SetTicks(location->row, column, tick, tick);
+    return target->GetComponent(location->row, column);
+}
+
+Archetype* ArchetypeStorage::AddEntities(std::span<const Entity> entities, std::span<const ComponentTypeInfo* const> types, ChangeTick tick) {
+    if (types.empty() || entities.empty()) {
+        return nullptr;
+    }
+    Archetype* archetype = FindOrCreateArchetype(types);
+
+    u32 maxIndex = 0;
+    for (Entity entity : entities) {
+        maxIndex = std::max(maxIndex, GetEntityIndex(entity));
+    }
+    if (maxIndex >= m_Locations.size()) {
+        m_Locations.resize(static_cast<usize>(maxIndex) + 1);
+    }
+
+    const i32 columnCount = static_cast<i32>(archetype->GetColumns().size());
+    for (Entity entity : entities) {
+        EntityLocation& location = m_Locations[GetEntityIndex(entity)];
+        ENJIN_ASSERT(!location.archetype, "AddEntities on an entity that already has components");
+        const usize row = archetype->PushRow(entity);
+        for (i32 column = 0; column < columnCount; ++column) {
+            archetype->SetTicks(row, column, tick, tick);
+        }
+        location = { archetype, row };
+    }
+    return archetype;
+}
+
+void ArchetypeStorage::Remove(Entity entity, ComponentTypeId type) {
+    EntityLocation* location = FindLocation(entity);
+    if (!location || !location->archetype || !location->archetype->Has(type)) {
+        return;
+    }
+
+    Archetype* target = GetRemoveTarget(location->archetype, type);
+    if (target) {
+        MoveEntity(entity, *location, target);
+    } else {
+        // Last component: the entity leaves archetype storage entirely
+        location->archetype->DestroyRow(location->row);
+        RemoveRow(location->archetype, location->row);
+        *location = {};
+    }
+}
+
+void* ArchetypeStorage::Get(Entity entity, ComponentTypeId type) const {
+    const EntityLocation* location = FindLocation(entity);
+    if (!location || !location->archetype) {
+        return nullptr;
+    }
+    const i32 column = location->archetype->GetColumnIndex(type);
+    return column >= 0 ? location->archetype->GetComponent(location->row, column) : nullptr;
+}
+
+void* ArchetypeStorage::GetMutable(Entity entity, ComponentTypeId type, ChangeTick tick) {
+    EntityLocation* location = FindLocation(entity);
+    if (!location || !location->archetype) {
+        return nullptr;
+    }
+    const i32 column = location->archetype->GetColumnIndex(type);
+    if (column < 0) {
+        return nullptr;
+    }
+    location->archetype->SetChangedTick(location->row, column, tick);
+    return location->archetype->GetComponent(location->row, column);
+}
+
+void ArchetypeStorage::DestroyEntity(Entity entity) {
+    EntityLocation* location = FindLocation(entity);
+    if (!location || !location->archetype) {
+        return;
+    }
+    location->archetype->DestroyRow(location->row);
+    RemoveRow(location->archetype, location->row);
+    *location = {};
+}
+
+void ArchetypeStorage::Clear() {
+    std::pmr::polymorphic_allocator<> allocator(m_Resource);
+    for (Archetype* archetype : m_Archetypes) {
+        allocator.delete_object(archetype);
+    }
+    m_Archetypes.clear();
+    m_Locations.clear();
+}
+
+Archetype* ArchetypeStorage::FindOrCreateArchetype(std::span<const ComponentTypeInfo* const> types) {
+    // Only reached when a transition isn't cached yet or on a bulk spawn,
+    // so a scan is fine
+    for (Archetype* archetype : m_Archetypes) {
+        const auto& columns = archetype->GetColumns();
+        if (columns.size() == types.size() &&
+            std::equal(columns.begin(), columns.end(), types.begin(),
+                       [](const Archetype::Column& column, const ComponentTypeInfo* info) { return column.info->id == info->id; })) {
+            return archetype;
+        }
+    }
+
+    std::pmr::polymorphic_allocator<> allocator(m_Resource);
+    Archetype* archetype = allocator.new_object<Archetype>(types, m_Resource);
+    m_Archetypes.push_back(archetype);
+    return archetype;
+}
+
+Archetype* ArchetypeStorage::GetAddTarget(Archetype* from, const ComponentTypeInfo& info) {
+    if (from && info.id < from->m_AddEdges.size() && from->m_AddEdges[info.id]) {
+        return from->m_AddEdges[info.id];
+    }
+
+    pmr::Vector<const ComponentTypeInfo*> types(m_Resource);
+    if (from) {
+        for (const Archetype::Column& column : from->GetColumns()) {
+            types.push_back(column.info);
+        }
+    }
+    types.insert(std::upper_bound(types.begin(), types.end(), &info,
+                                  [](const ComponentTypeInfo* a, const ComponentTypeInfo* b) { return a->id < b->id; }),
+                 &info);
+    Archetype* target = FindOrCreateArchetype(types);
+
+    if (from) {
+        if (info.id >= from->m_AddEdges.size()) {
+            from->m_AddEdges.resize(static_cast<usize>(info.id) + 1, nullptr);
+        }
+        from->m_AddEdges[info.id] = target;
+    }
+    return target;
+}
+
+Archetype* ArchetypeStorage::GetRemoveTarget(Archetype* from, ComponentTypeId type) {
+    if (from->GetColumns().size() == 1) {
+        return nullptr;
+    }
+    if (type < from->m_RemoveEdges.size() && from->m_RemoveEdges[type]) {
+        return from->m_RemoveEdges[type];
+    }
+
+    pmr::Vector<const ComponentTypeInfo*> types(m_Resource);
+    for (const Archetype::Column& column : from->GetColumns()) {
+        if (column.info->id != type) {
+            types.push_back(column.info);
+        }
+    }
+    Archetype* target = FindOrCreateArchetype(types);
+
+    if (type >= from->m_RemoveEdges.size()) {
+        from->m_RemoveEdges.resize(static_cast<usize>(type) + 1, nullptr);
+    }
+    from->m_RemoveEdges[type] = target;
+    return target;
+}
+
+void ArchetypeStorage::MoveEntity(Entity entity, EntityLocation& location, Archetype* target) {
+    const usize row = target->PushRow(entity);
+
+    if (Archetype* source = location.archetype) {
+        const auto& columns = source->GetColumns();
+        for (i32 column = 0; column < static_cast<i32>(columns.size()); ++column) {
+            void* src = source->GetComponent(location.row, column);
+            const i32 targetColumn = target->GetColumnIndex(columns[column].info->id);
+            if (targetColumn >= 0) {
+                Relocate(*columns[column].info, target->GetComponent(row, targetColumn), src);
+                target->SetTicks(row, targetColumn, source->GetAddedTick(location.row, column), source->GetChangedTick(location.row, column));
+            } else {
+                Destroy(*columns[column].info, src);
+            }
+        }
+        RemoveRow(source, location.row);
+    }
+
+    location.archetype = target;
+    location.row = row;
+}
+
+void ArchetypeStorage::RemoveRow(Archetype* archetype, usize row) {
+    const Entity moved = archetype->RemoveRow(row);
+    if (moved != INVALID_ENTITY) {
+        m_Locations[GetEntityIndex(moved)].row = row;
+    }
+}
+
+} // namespace ECS
+} // namespace Enjin
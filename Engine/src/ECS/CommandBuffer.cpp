@@ -0,0 +1,135 @@
+#include "Enjin/ECS/CommandBuffer.h"
+#include "Enjin/Core/Assert.h"
+#include <algorithm>
+
+/**
+ * @file CommandBuffer.cpp
+ * @brief Implementation of CommandBuffer recording and sorted playback
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+namespace ECS {
+
+CommandBuffer::CommandBuffer(World& world)
+    : CommandBuffer(world, world.GetMemoryResource()) {
+}
+
+CommandBuffer::CommandBuffer(World& world, std::pmr::memory_resource* resource)
+    : m_World(world)
+    , m_Commands(resource)
+    , m_Created(resource)
+    , m_Payloads(resource) {
+}
+
+CommandBuffer::~CommandBuffer() {
+    Clear();
+}
+
+Entity CommandBuffer::CreateEntity() {
+    ENJIN_ASSERT(m_PendingCreates < 0xFFFFFFFFu, "Too many deferred entity creations");
+    return MakeEntity(++m_PendingCreates, 0);
+}
+
+void CommandBuffer::DestroyEntity(Entity entity) {
+    Record({ entity, 0, CommandType::Destroy, nullptr, nullptr, nullptr });
+}
+
+Entity CommandBuffer::Resolve(Entity entity) const {
+    if (!IsPlaceholder(entity)) {
+        return entity;
+    }
+    const u32 index = GetEntityIndex(entity) - 1;
+    return index < m_Created.size() ? m_Created[index] : entity;
+}
+
+void CommandBuffer::Playback() {
+    CommandBuffer* self = this;
+    Playback(m_World, std::span<CommandBuffer* const>(&self, 1));
+}
+
+void CommandBuffer::Playback(World& world, std::span<CommandBuffer* const> buffers) {
+    std::pmr::memory_resource* resource = world.GetMemoryResource();
+    pmr::Vector<Entity> destroyed(resource);
+
+    // Creations first, so later commands can refer to the new entities.
+    // Then count the component commands per type for a counting sort.
+    pmr::Vector<usize> typeOffsets(static_cast<usize>(ComponentRegistry::GetNextId()) + 1, 0, resource);
+    for (CommandBuffer* buffer : buffers) {
+        ENJIN_ASSERT(&buffer->m_World == &world, "Playing back a command buffer on another world");
+        buffer->ResolveCreates();
+        for (const Command& command : buffer->m_Commands) {
+            if (command.kind != CommandType::Destroy) {
+                ++typeOffsets[command.type + 1];
+            }
+        }
+    }
+    for (usize type = 1; type < typeOffsets.size(); ++type) {
+        typeOffsets[type] += typeOffsets[type - 1];
+    }
+
+    // Scatter grouped by storage, keeping recorded order within each type
+    pmr::Vector<Command> commands(typeOffsets.back(), resource);
+    pmr::Vector<usize> cursor(typeOffsets.begin(), typeOffsets.end() - 1, resource);
+    for (CommandBuffer* buffer : buffers) {
+        for (Command command : buffer->m_Commands) {
+            command.entity = buffer->Resolve(command.entity);
+            if (command.kind == CommandType::Destroy) {
+                destroyed.push_back(command.entity);
+            } else {
+                commands[cursor[command.type]++] = command;
+            }
+        }
+    }
+
+    auto byEntity = [](const Command& a, const Command& b) {
+        return GetEntityIndex(a.entity) < GetEntityIndex(b.entity);
+    };
+    for (usize type = 0; type + 1 < typeOffsets.size(); ++type) {
+        const usize begin = typeOffsets[type];
+        const usize end = typeOffsets[type + 1];
+        if (begin == end) {
+            continue;
+        }
+        // Entity order walks the sparse pages front to back. Commands recorded
+        // during iteration usually arrive sorted already; stable keeps each
+        // entity's commands (add-then-remove stays a removal) in order.
+        if (!std::is_sorted(commands.begin() + begin, commands.begin() + end, byEntity)) {
+            std::stable_sort(commands.begin() + begin, commands.begin() + end, byEntity);
+        }
+        commands[begin].apply(world, std::span<const Command>(commands.data() + begin, end - begin));
+    }
+
+    // Destruction last: it overrides anything else recorded for the entity
+    std::sort(destroyed.begin(), destroyed.end());
+    destroyed.erase(std::unique(destroyed.begin(), destroyed.end()), destroyed.end());
+    world.DestroyEntities(destroyed);
+
+    for (CommandBuffer* buffer : buffers) {
+        buffer->Reset(); // Payloads were moved from and destroyed by apply
+    }
+}
+
+void CommandBuffer::Clear() {
+    for (const Command& command : m_Commands) {
+        if (command.payload) {
+            command.destroyPayload(command.payload);
+        }
+    }
+    Reset();
+}
+
+void CommandBuffer::ResolveCreates() {
+    m_Created.resize(m_PendingCreates);
+    m_World.CreateEntities(m_Created);
+}
+
+void CommandBuffer::Reset() {
+    m_Commands.clear();
+    m_PendingCreates = 0;
+    m_Payloads.release();
+}
+
+} // namespace ECS
+} // namespace Enjin
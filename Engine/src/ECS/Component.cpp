@@ -1,9 +1,85 @@
 #include "Enjin/ECS/Component.h"
+#include "Enjin/Core/Assert.h"
+#include "Enjin/Logging/Log.h"
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace Enjin {
 namespace ECS {
 
-ComponentTypeId ComponentRegistry::s_NextComponentId = 1;
+namespace {
+
+struct TypeTable {
+    std::mutex mutex;
+    std::unordered_map<ComponentTypeHash, ComponentTypeId> idByHash;
+    std::vector<ComponentTypeHash> hashById{ 0 }; // Id 0 is never handed out
+    std::vector<std::string> nameById{ std::string() };
+    std::atomic<ComponentTypeId> nextId{1};
+};
+
+// Constructed on first use: GetTypeId may run during static initialization
+TypeTable& GetTypeTable() {
+    static TypeTable table;
+    return table;
+}
+
+} // namespace
+
+ComponentTypeId ComponentRegistry::Register(ComponentTypeHash hash, std::string_view name) {
+    TypeTable& table = GetTypeTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    // GCC spells it {anonymous}, Clang (anonymous namespace), MSVC `anonymous namespace'
+    const bool local = name.find("{anonymous}") != std::string_view::npos ||
+                       name.find("anonymous namespace") != std::string_view::npos;
+    if (!local) {
+        auto it = table.idByHash.find(hash);
+        if (it != table.idByHash.end()) {
+            // Same type seen from another module, or a genuine hash collision
+            ENJIN_ASSERT(table.nameById[it->second] == name, "Component type hash collision");
+            if (table.nameById[it->second] != name) {
+                ENJIN_LOG_ERROR(Core, "Component types %s and %.*s share hash %llx",
+                                table.nameById[it->second].c_str(), static_cast<int>(name.size()), name.data(),
+                                static_cast<unsigned long long>(hash));
+            }
+            return it->second;
+        }
+    }
+
+    const ComponentTypeId id = table.nextId.load(std::memory_order_relaxed);
+    if (id >= MAX_COMPONENT_TYPES) {
+        // Every ComponentMask would index past its words; not recoverable
+        ENJIN_LOG_FATAL(Core, "Component type %.*s exceeds MAX_COMPONENT_TYPES (%zu); raise it",
+                        static_cast<int>(name.size()), name.data(), MAX_COMPONENT_TYPES);
+        std::abort();
+    }
+    table.hashById.push_back(hash);
+    table.nameById.emplace_back(name);
+    table.idByHash.emplace(hash, id); // Keeps the first of several local types with one name
+    table.nextId.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+ComponentTypeId ComponentRegistry::FindTypeId(ComponentTypeHash hash) {
+    TypeTable& table = GetTypeTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto it = table.idByHash.find(hash);
+    return it != table.idByHash.end() ? it->second : 0;
+}
+
+ComponentTypeHash ComponentRegistry::GetTypeHash(ComponentTypeId id) {
+    TypeTable& table = GetTypeTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return id < table.hashById.size() ? table.hashById[id] : 0;
+}
+
+ComponentTypeId ComponentRegistry::GetNextId() {
+    return GetTypeTable().nextId.load(std::memory_order_acquire);
+}
 
 } // namespace ECS
 } // namespace Enjin
@@ -5,32 +5,66 @@
 namespace Enjin {
 namespace ECS {
 
-EntityManager::EntityManager() {
+EntityManager::EntityManager(std::pmr::memory_resource* resource)
+    : m_Generations(resource), m_FreeIndices(resource) {
 }
 
 EntityManager::~EntityManager() {
 }
 
 Entity EntityManager::CreateEntity() {
-    Entity entity = m_NextEntity++;
-    if (m_NextEntity == INVALID_ENTITY) {
-        m_NextEntity = 1; // Wrap around (skip 0)
+    if (!m_FreeIndices.empty()) {
+        const u32 index = m_FreeIndices.back();
+        m_FreeIndices.pop_back();
+        return MakeEntity(index, m_Generations[index]);
     }
-    return entity;
+
+    ENJIN_ASSERT(m_Generations.size() < 0xFFFFFFFFu, "Entity index space exhausted");
+    const u32 index = static_cast<u32>(m_Generations.size());
+    m_Generations.push_back(1);
+    return MakeEntity(index, 1);
 }
 
-void EntityManager::DestroyEntity(Entity entity) {
-    // In a full implementation, you'd mark the entity as destroyed
-    // and potentially reuse its ID. For now, we just validate.
-    (void)entity;
+void EntityManager::CreateEntities(std::span<Entity> entities) {
+    usize i = 0;
+    for (; i < entities.size() && !m_FreeIndices.empty(); ++i) {
+        const u32 index = m_FreeIndices.back();
+        m_FreeIndices.pop_back();
+        entities[i] = MakeEntity(index, m_Generations[index]);
+    }
+    if (i == entities.size()) {
+        return;
+    }
+
+    const usize first = m_Generations.size();
+    const usize count = entities.size() - i;
+    ENJIN_ASSERT(first + count < 0xFFFFFFFFu, "Entity index space exhausted");
+    m_Generations.resize(first + count, 1);
+    for (usize j = 0; j < count; ++j) {
+        entities[i + j] = MakeEntity(static_cast<u32>(first + j), 1);
+    }
 }
 
-bool EntityManager::IsValid(Entity entity) const {
-    return entity != INVALID_ENTITY;
+void EntityManager::DestroyEntity(Entity entity) {
+    if (!IsValid(entity)) {
+        return;
+    }
+    const u32 index = GetEntityIndex(entity);
+
+    // Skip 0 on wrap-around so a recycled handle is never INVALID_ENTITY
+    u32& generation = m_Generations[index];
+    generation = generation == 0xFFFFFFFFu ? 1 : generation + 1;
+    m_FreeIndices.push_back(index);
 }
 
 void EntityManager::Reset() {
-    m_NextEntity = 1;
+    m_Generations.clear();
+    m_FreeIndices.clear();
+}
+
+void EntityManager::Restore(std::span<const u32> generations, std::span<const u32> freeIndices) {
+    m_Generations.assign(generations.begin(), generations.end());
+    m_FreeIndices.assign(freeIndices.begin(), freeIndices.end());
 }
 
 } // namespace ECS
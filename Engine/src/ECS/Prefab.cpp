@@ -0,0 +1,127 @@
+#include "Enjin/ECS/Prefab.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+/**
+ * @file Prefab.cpp
+ * @brief Prefab blob management
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+namespace ECS {
+
+namespace {
+
+usize AlignUp(usize value, usize alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+Prefab::Prefab(std::pmr::memory_resource* resource)
+    : m_Resource(resource), m_Columns(resource) {
+}
+
+Prefab::~Prefab() {
+    Release();
+}
+
+Prefab::Prefab(Prefab&& other) noexcept
+    : m_Resource(other.m_Resource)
+    , m_Columns(std::move(other.m_Columns))
+    , m_Mask(other.m_Mask)
+    , m_Data(std::exchange(other.m_Data, nullptr))
+    , m_Size(std::exchange(other.m_Size, 0))
+    , m_Capacity(std::exchange(other.m_Capacity, 0))
+    , m_Alignment(other.m_Alignment) {
+    other.m_Columns.clear();
+    other.m_Mask = ComponentMask();
+}
+
+Prefab& Prefab::operator=(Prefab&& other) noexcept {
+    if (this != &other) {
+        Release();
+        m_Resource = other.m_Resource;
+        m_Columns = std::move(other.m_Columns);
+        m_Mask = std::exchange(other.m_Mask, ComponentMask());
+        m_Data = std::exchange(other.m_Data, nullptr);
+        m_Size = std::exchange(other.m_Size, 0);
+        m_Capacity = std::exchange(other.m_Capacity, 0);
+        m_Alignment = other.m_Alignment;
+        other.m_Columns.clear();
+    }
+    return *this;
+}
+
+void* Prefab::Acquire(const ComponentTypeInfo& info, FillFn fill, AppendFn append) {
+    for (const Column& column : m_Columns) {
+        if (column.info->id == info.id) {
+            void* slot = m_Data + column.offset;
+            if (info.destroy) {
+                info.destroy(slot);
+            }
+            return slot;
+        }
+    }
+
+    const usize offset = AlignUp(m_Size, info.alignment);
+    const usize size = offset + info.size;
+    if (size > m_Capacity || info.alignment > m_Alignment) {
+        // Values are relocated, not copied: the blob owns them
+        const usize capacity = std::max(size, m_Capacity * 2);
+        const usize alignment = std::max<usize>(m_Alignment, info.alignment);
+        u8* data = static_cast<u8*>(m_Resource->allocate(capacity, alignment));
+        for (const Column& column : m_Columns) {
+            if (column.info->relocate) {
+                column.info->relocate(data + column.offset, m_Data + column.offset);
+            } else {
+                std::memcpy(data + column.offset, m_Data + column.offset, column.info->size);
+            }
+        }
+        if (m_Data) {
+            m_Resource->deallocate(m_Data, m_Capacity, m_Alignment);
+        }
+        m_Data = data;
+        m_Capacity = capacity;
+        m_Alignment = alignment;
+    }
+
+    m_Columns.push_back({ &info, static_cast<u32>(offset), fill, append });
+    m_Mask.Set(info.id);
+    m_Size = size;
+    return m_Data + offset;
+}
+
+const Prefab::Column* Prefab::FindColumn(ComponentTypeId typeId) const {
+    if (!m_Mask.Test(typeId)) {
+        return nullptr;
+    }
+    for (const Column& column : m_Columns) {
+        if (column.info->id == typeId) {
+            return &column;
+        }
+    }
+    return nullptr;
+}
+
+void Prefab::Release() {
+    for (const Column& column : m_Columns) {
+        if (column.info->destroy) {
+            column.info->destroy(m_Data + column.offset);
+        }
+    }
+    if (m_Data) {
+        m_Resource->deallocate(m_Data, m_Capacity, m_Alignment);
+    }
+    m_Columns.clear();
+    m_Mask = ComponentMask();
+    m_Data = nullptr;
+    m_Size = 0;
+    m_Capacity = 0;
+}
+
+} // namespace ECS
+} // namespace Enjin
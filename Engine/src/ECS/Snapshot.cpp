@@ -0,0 +1,280 @@
+#include "Enjin/ECS/Snapshot.h"
+#include "Enjin/Core/Assert.h"
+#include "Enjin/Logging/Log.h"
+#include "Enjin/Memory/Memory.h"
+#include <algorithm>
+
+/**
+ * @file Snapshot.cpp
+ * @brief Snapshot file writing and validation of mapped snapshots
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+namespace ECS {
+
+namespace {
+
+// Component arrays start on a cache line, whatever their type's alignment
+constexpr usize COMPONENT_ARRAY_ALIGNMENT = CACHE_LINE_SIZE;
+
+bool IsPowerOfTwo(u64 value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+} // namespace
+
+// ============================================================================
+// SnapshotWriter
+// ============================================================================
+
+SnapshotWriter::SnapshotWriter(std::pmr::memory_resource* resource)
+    : m_Tables(resource) {
+}
+
+SnapshotWriter::~SnapshotWriter() {
+    if (m_File) {
+        std::fclose(m_File); // Unfinished: the header never got its magic
+    }
+}
+
+bool SnapshotWriter::Open(const std::string& path, std::span<const u32> generations, std::span<const u32> freeIndices) {
+    ENJIN_ASSERT(!m_File, "SnapshotWriter is already open");
+    m_File = std::fopen(path.c_str(), "wb");
+    if (!m_File) {
+        ENJIN_LOG_ERROR(Core, "Cannot create snapshot %s", path.c_str());
+        return false;
+    }
+    m_Path = path;
+    m_Offset = 0;
+    m_Failed = false;
+    m_Tables.clear();
+
+    m_Header = SnapshotHeader();
+    Write(&m_Header, sizeof(m_Header)); // Placeholder until Close()
+
+    m_Header.generationCount = static_cast<u32>(generations.size());
+    m_Header.generationsOffset = m_Offset;
+    Write(generations.data(), generations.size_bytes());
+
+    m_Header.freeCount = static_cast<u32>(freeIndices.size());
+    m_Header.freeOffset = m_Offset;
+    Write(freeIndices.data(), freeIndices.size_bytes());
+    return !m_Failed;
+}
+
+void SnapshotWriter::BeginTable(ComponentTypeHash hash, u32 size, u32 alignment) {
+    ENJIN_ASSERT(IsPowerOfTwo(alignment) && size > 0, "Invalid component layout");
+    Pad(alignof(Entity));
+    m_Table = SnapshotTable();
+    m_Table.hash = hash;
+    m_Table.size = size;
+    m_Table.alignment = alignment;
+    m_Table.entitiesOffset = m_Offset;
+    m_ComponentRows = 0;
+}
+
+void SnapshotWriter::WriteEntities(const Entity* entities, usize count) {
+    ENJIN_ASSERT(m_Table.componentsOffset == 0, "All of a table's entities go before its components");
+    Write(entities, count * sizeof(Entity));
+    m_Table.count += count;
+}
+
+void SnapshotWriter::WriteComponents(const void* components, usize count) {
+    if (m_Table.componentsOffset == 0) {
+        Pad(std::max<usize>(m_Table.alignment, COMPONENT_ARRAY_ALIGNMENT));
+        m_Table.componentsOffset = m_Offset;
+    }
+    Write(components, count * m_Table.size);
+    m_ComponentRows += count;
+}
+
+void SnapshotWriter::EndTable() {
+    if (m_Table.componentsOffset == 0) {
+        WriteComponents(nullptr, 0); // Empty table
+    }
+    ENJIN_ASSERT(m_ComponentRows == m_Table.count, "Snapshot table has a different number of entities and components");
+    if (m_ComponentRows != m_Table.count) {
+        m_Failed = true;
+    }
+    m_Tables.push_back(m_Table);
+}
+
+bool SnapshotWriter::Close() {
+    if (!m_File) {
+        return false;
+    }
+
+    Pad(alignof(SnapshotTable));
+    m_Header.tablesOffset = m_Offset;
+    m_Header.tableCount = static_cast<u32>(m_Tables.size());
+    Write(m_Tables.data(), m_Tables.size() * sizeof(SnapshotTable));
+
+    m_Header.fileSize = m_Offset;
+    m_Header.version = SNAPSHOT_VERSION;
+    m_Header.magic = m_Failed ? 0 : SNAPSHOT_MAGIC;
+    if (std::fseek(m_File, 0, SEEK_SET) != 0 || std::fwrite(&m_Header, sizeof(m_Header), 1, m_File) != 1) {
+        m_Failed = true;
+    }
+    if (std::fclose(m_File) != 0) {
+        m_Failed = true;
+    }
+    m_File = nullptr;
+
+    if (m_Failed) {
+        ENJIN_LOG_ERROR(Core, "Failed to write snapshot %s", m_Path.c_str());
+    }
+    return !m_Failed;
+}
+
+void SnapshotWriter::Write(const void* data, usize bytes) {
+    if (bytes == 0 || m_Failed) {
+        return;
+    }
+    if (std::fwrite(data, bytes, 1, m_File) != 1) {
+        m_Failed = true;
+    }
+    m_Offset += bytes;
+}
+
+void SnapshotWriter::Pad(usize alignment) {
+    static constexpr u8 zeros[COMPONENT_ARRAY_ALIGNMENT] = {};
+    for (usize padding = (alignment - m_Offset % alignment) % alignment; padding > 0;) {
+        const usize bytes = std::min(padding, sizeof(zeros));
+        Write(zeros, bytes);
+        padding -= bytes;
+    }
+}
+
+// ============================================================================
+// SnapshotReader
+// ============================================================================
+
+bool SnapshotReader::Open(const std::string& path) {
+    if (!m_File.Open(path)) {
+        ENJIN_LOG_ERROR(Core, "Cannot open snapshot %s", path.c_str());
+        return false;
+    }
+    if (!Validate(path)) {
+        m_File.Close();
+        return false;
+    }
+    return true;
+}
+
+bool SnapshotReader::Validate(const std::string& path) const {
+    auto fail = [&path](const char* reason) {
+        ENJIN_LOG_ERROR(Core, "Snapshot %s: %s", path.c_str(), reason);
+        return false;
+    };
+    const u64 fileSize = m_File.GetSize();
+    // Whether count elements of elementSize bytes at offset lie inside the file
+    auto inside = [fileSize](u64 offset, u64 count, u64 elementSize, u64 alignment) {
+        return offset % alignment == 0 && offset <= fileSize && count <= (fileSize - offset) / elementSize;
+    };
+
+    if (fileSize < sizeof(SnapshotHeader)) {
+        return fail("truncated");
+    }
+    const SnapshotHeader& header = GetHeader();
+    if (header.magic != SNAPSHOT_MAGIC) {
+        return fail("not a snapshot, or an incomplete one");
+    }
+    if (header.version != SNAPSHOT_VERSION) {
+        return fail("unsupported version");
+    }
+    if (header.fileSize != fileSize) {
+        return fail("size mismatch");
+    }
+    if (!inside(header.generationsOffset, header.generationCount, sizeof(u32), alignof(u32)) ||
+        !inside(header.freeOffset, header.freeCount, sizeof(u32), alignof(u32)) ||
+        !inside(header.tablesOffset, header.tableCount, sizeof(SnapshotTable), alignof(SnapshotTable))) {
+        return fail("entity table or table directory out of bounds");
+    }
+
+    const std::span<const u32> generations = GetGenerations();
+    // One bit per entity index: free ones, and those listed by the table being checked
+    const usize words = (generations.size() + 63) / 64;
+    pmr::Vector<u64> free(words, 0);
+    pmr::Vector<u64> listed(words, 0);
+    auto testAndSet = [](pmr::Vector<u64>& bits, u32 index) {
+        const u64 bit = u64(1) << (index % 64);
+        const bool wasSet = (bits[index / 64] & bit) != 0;
+        bits[index / 64] |= bit;
+        return wasSet;
+    };
+
+    for (u32 index : GetFreeIndices()) {
+        if (index >= generations.size()) {
+            return fail("free index out of range");
+        }
+        if (testAndSet(free, index)) {
+            return fail("free index listed twice");
+        }
+    }
+
+    for (const SnapshotTable& table : GetTables()) {
+        if (table.size == 0 || !IsPowerOfTwo(table.alignment) ||
+            !inside(table.entitiesOffset, table.count, sizeof(Entity), alignof(Entity)) ||
+            !inside(table.componentsOffset, table.count, table.size, table.alignment)) {
+            return fail("component table out of bounds");
+        }
+        const std::span<const Entity> entities = GetEntities(table);
+        for (Entity entity : entities) {
+            const u32 index = GetEntityIndex(entity);
+            if (index >= generations.size() || generations[index] != GetEntityGeneration(entity)) {
+                return fail("component of an entity missing from the entity table");
+            }
+            if (free[index / 64] & (u64(1) << (index % 64))) {
+                return fail("component of a free entity");
+            }
+            if (testAndSet(listed, index)) {
+                return fail("component table lists an entity twice");
+            }
+        }
+        // Clear only this table's bits, so each table costs its own size
+        for (Entity entity : entities) {
+            const u32 index = GetEntityIndex(entity);
+            listed[index / 64] &= ~(u64(1) << (index % 64));
+        }
+    }
+    return true;
+}
+
+std::span<const u32> SnapshotReader::GetGenerations() const {
+    const SnapshotHeader& header = GetHeader();
+    return { reinterpret_cast<const u32*>(m_File.GetData() + header.generationsOffset), header.generationCount };
+}
+
+std::span<const u32> SnapshotReader::GetFreeIndices() const {
+    const SnapshotHeader& header = GetHeader();
+    return { reinterpret_cast<const u32*>(m_File.GetData() + header.freeOffset), header.freeCount };
+}
+
+std::span<const SnapshotTable> SnapshotReader::GetTables() const {
+    const SnapshotHeader& header = GetHeader();
+    return { reinterpret_cast<const SnapshotTable*>(m_File.GetData() + header.tablesOffset), header.tableCount };
+}
+
+const SnapshotTable* SnapshotReader::FindTable(ComponentTypeHash hash, u32 size, u32 alignment) const {
+    for (const SnapshotTable& table : GetTables()) {
+        if (table.hash != hash) {
+            continue;
+        }
+        if (table.size != size || table.alignment != alignment) {
+            ENJIN_LOG_WARN(Core, "Snapshot component %llx changed layout since it was saved; skipping it",
+                           static_cast<unsigned long long>(hash));
+            return nullptr;
+        }
+        return &table;
+    }
+    return nullptr;
+}
+
+std::span<const Entity> SnapshotReader::GetEntities(const SnapshotTable& table) const {
+    return { reinterpret_cast<const Entity*>(m_File.GetData() + table.entitiesOffset), static_cast<usize>(table.count) };
+}
+
+} // namespace ECS
+} // namespace Enjin
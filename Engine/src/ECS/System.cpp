@@ -1,30 +1,189 @@
 #include "Enjin/ECS/System.h"
 #include "Enjin/Logging/Log.h"
+#include "Enjin/Threading/JobSystem.h"
+#include <algorithm>
+#include <atomic>
 
 namespace Enjin {
 namespace ECS {
 
-SystemManager::SystemManager() {
+namespace {
+
+template<typename Key>
+bool Intersects(const std::vector<Key>& a, const std::vector<Key>& b) {
+    for (Key type : a) {
+        if (std::find(b.begin(), b.end(), type) != b.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+// ============================================================================
+// SystemAccess
+// ============================================================================
+
+void SystemAccess::Add(std::vector<ComponentTypeId>& types, ComponentTypeId type) {
+    if (std::find(types.begin(), types.end(), type) == types.end()) {
+        types.push_back(type);
+    }
+}
+
+void SystemAccess::Add(std::vector<ComponentTypeHash>& resources, ComponentTypeHash resource) {
+    if (std::find(resources.begin(), resources.end(), resource) == resources.end()) {
+        resources.push_back(resource);
+    }
+}
+
+bool SystemAccess::ConflictsWith(const SystemAccess& other) const {
+    if (m_Exclusive || other.m_Exclusive) {
+        return true;
+    }
+    return Intersects(m_Writes, other.m_Writes) ||
+           Intersects(m_Writes, other.m_Reads) ||
+           Intersects(m_Reads, other.m_Writes) ||
+           Intersects(m_ResourceWrites, other.m_ResourceWrites) ||
+           Intersects(m_ResourceWrites, other.m_ResourceReads) ||
+           Intersects(m_ResourceReads, other.m_ResourceWrites);
+}
+
+// ============================================================================
+// SystemManager
+// ============================================================================
+
+// One system in the dependency graph. Edges only join systems of the same
+// batch (a run of non-exclusive systems between two exclusive ones).
+struct SystemManager::Node {
+    SystemManager* manager = nullptr;
+    ISystem* system = nullptr;
+    SystemAccess access;
+    std::vector<u32> successors;   // Later systems in the batch that conflict with this one
+    u32 predecessors = 0;
+    std::atomic<u32> remaining{0}; // Predecessors still running this frame
+    JobCounter* counter = nullptr; // Batch completion
+};
+
+SystemManager::SystemManager(std::atomic<ChangeTick>& changeTick)
+    : m_ChangeTick(changeTick) {
 }
 
 SystemManager::~SystemManager() {
 }
 
+void SystemManager::BuildGraph() {
+    const usize count = m_Systems.size();
+    m_Nodes = std::make_unique<Node[]>(count);
+    for (usize i = 0; i < count; ++i) {
+        m_Nodes[i].manager = this;
+        m_Nodes[i].system = m_Systems[i].get();
+        m_Systems[i]->DeclareAccess(m_Nodes[i].access);
+    }
+
+    usize batchBegin = 0;
+    for (usize j = 0; j < count; ++j) {
+        Node& node = m_Nodes[j];
+        if (node.access.IsExclusive()) {
+            batchBegin = j + 1;
+            continue;
+        }
+        for (usize i = batchBegin; i < j; ++i) {
+            if (m_Nodes[i].access.ConflictsWith(node.access)) {
+                m_Nodes[i].successors.push_back(static_cast<u32>(j));
+                ++node.predecessors;
+            }
+        }
+    }
+    m_GraphDirty = false;
+}
+
 void SystemManager::Update(f32 deltaTime) {
-    for (auto& system : m_Systems) {
-        system->Update(deltaTime);
+    if (!JobSystem::IsInitialized()) {
+        for (auto& system : m_Systems) {
+            RunSystem(*system, deltaTime);
+        }
+        m_ChangeTick.fetch_add(1, std::memory_order_relaxed);
+        return;
     }
+
+    if (m_GraphDirty) {
+        BuildGraph();
+    }
+    m_DeltaTime = deltaTime;
+
+    const usize count = m_Systems.size();
+    usize i = 0;
+    while (i < count) {
+        if (m_Nodes[i].access.IsExclusive()) {
+            RunSystem(*m_Systems[i], deltaTime);
+            ++i;
+            continue;
+        }
+        usize end = i + 1;
+        while (end < count && !m_Nodes[end].access.IsExclusive()) {
+            ++end;
+        }
+        RunBatch(i, end);
+        i = end;
+    }
+    // Writes made between frames must be newer than every system's last run
+    m_ChangeTick.fetch_add(1, std::memory_order_relaxed);
 }
 
-void SystemManager::OnEntityAdded(Entity entity) {
-    for (auto& system : m_Systems) {
-        system->OnEntityAdded(entity);
+// The last run tick can cover writes of systems that ran alongside this one;
+// those only touch components it doesn't declare, since systems that
+// conflict never overlap
+void SystemManager::RunSystem(ISystem& system, f32 deltaTime) {
+    m_ChangeTick.fetch_add(1, std::memory_order_relaxed);
+    system.Update(deltaTime);
+    system.m_LastRunTick = m_ChangeTick.load(std::memory_order_relaxed);
+}
+
+void SystemManager::RunBatch(usize begin, usize end) {
+    if (end - begin == 1) {
+        RunSystem(*m_Systems[begin], m_DeltaTime);
+        return;
+    }
+
+    JobCounter counter;
+    for (usize i = begin; i < end; ++i) {
+        m_Nodes[i].remaining.store(m_Nodes[i].predecessors, std::memory_order_relaxed);
+        m_Nodes[i].counter = &counter;
+    }
+    for (usize i = begin; i < end; ++i) {
+        if (m_Nodes[i].predecessors == 0) {
+            JobSystem::Run(&SystemManager::RunNode, &m_Nodes[i], &counter);
+        }
+    }
+    JobSystem::Wait(counter);
+}
+
+void SystemManager::RunNode(void* data) {
+    Node& node = *static_cast<Node*>(data);
+    node.manager->RunSystem(*node.system, node.manager->m_DeltaTime);
+
+    // The last predecessor to finish releases a successor; it is queued before
+    // this job's own counter decrement, so the batch can't look done early
+    for (u32 index : node.successors) {
+        Node& successor = node.manager->m_Nodes[index];
+        if (successor.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            JobSystem::Run(&SystemManager::RunNode, &successor, successor.counter);
+        }
     }
 }
 
-void SystemManager::OnEntityRemoved(Entity entity) {
-    for (auto& system : m_Systems) {
-        system->OnEntityRemoved(entity);
+void SystemManager::OnComponentsChanged(Entity entity, const ComponentMask& before, const ComponentMask& after) {
+    const bool hadAny = !before.Empty();
+    const bool hasAny = !after.Empty();
+    for (usize i = 0; i < m_Systems.size(); ++i) {
+        const bool matched = hadAny && before.ContainsAll(m_Signatures[i]);
+        const bool matches = hasAny && after.ContainsAll(m_Signatures[i]);
+        if (matches && !matched) {
+            m_Systems[i]->OnEntityAdded(entity);
+        } else if (matched && !matches) {
+            m_Systems[i]->OnEntityRemoved(entity);
+        }
     }
 }
 
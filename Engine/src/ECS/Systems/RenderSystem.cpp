@@ -3,6 +3,7 @@
 #include "Enjin/Math/Math.h"
 #include "Enjin/Renderer/Vulkan/ShaderData.h"
 #include "Enjin/Renderer/Vulkan/VulkanPipeline.h"
+#include <array>
 #include <cstring>
 
 namespace Enjin {
@@ -103,10 +104,25 @@ void RenderSystem::Update(f32 deltaTime) {
         return;
     }
 
-    // Render all entities with Transform and Mesh components
-    if (m_TriangleEntity != INVALID_ENTITY) {
-        RenderEntity(m_TriangleEntity);
-    }
+    UpdateModelMatrices();
+
+    // Render all entities with Transform and Mesh components; the group keeps
+    // them packed at the front of both storages
+    m_World->Group<const TransformComponent, const MeshComponent>().Each(
+        [this](Entity entity, const TransformComponent&, const MeshComponent& mesh) {
+            RenderEntity(entity, mesh); // Model matrix comes from the cache
+        });
+}
+
+void RenderSystem::UpdateModelMatrices() {
+    const World& world = *m_World;
+    world.View<const TransformComponent>().Changed<TransformComponent>(GetLastRunTick()).Each(
+        [this](Entity entity, const TransformComponent& transform) {
+            auto it = m_EntityRenderData.find(entity);
+            if (it != m_EntityRenderData.end()) {
+                it->second.model = transform.ToMatrix();
+            }
+        });
 }
 
 void RenderSystem::OnEntityAdded(Entity entity) {
@@ -117,6 +133,11 @@ void RenderSystem::OnEntityRemoved(Entity entity) {
     m_EntityRenderData.erase(entity);
 }
 
+void RenderSystem::DeclareSignature(ComponentMask& signature) {
+    // Buffers are set up once the entity has both, not on every component add
+    signature = ComponentMask::Of<TransformComponent, MeshComponent>();
+}
+
 void RenderSystem::CreatePipeline() {
     Renderer::PipelineConfig config;
     config.renderPass = m_Renderer->GetRenderPass();
@@ -136,7 +157,7 @@ void RenderSystem::CreatePipeline() {
 
 void RenderSystem::CreateUniformBuffers() {
     constexpr usize bufferSize = sizeof(Renderer::UniformBufferObject);
-    constexpr u32 framesInFlight = 2; // Match renderer's MAX_FRAMES_IN_FLIGHT
+    constexpr u32 framesInFlight = Renderer::VulkanRenderer::MAX_FRAMES_IN_FLIGHT;
 
     m_UniformBuffers.resize(framesInFlight);
     for (u32 i = 0; i < framesInFlight; ++i) {
@@ -149,7 +170,7 @@ void RenderSystem::CreateUniformBuffers() {
 }
 
 void RenderSystem::CreateDescriptorSets() {
-    constexpr u32 framesInFlight = 2;
+    constexpr u32 framesInFlight = Renderer::VulkanRenderer::MAX_FRAMES_IN_FLIGHT;
 
     // Create descriptor pool
     VkDescriptorPoolSize poolSize{};
@@ -170,7 +191,9 @@ void RenderSystem::CreateDescriptorSets() {
     }
 
     // Allocate descriptor sets
-    std::vector<VkDescriptorSetLayout> layouts(framesInFlight, m_Pipeline->GetDescriptorSetLayout());
+    // framesInFlight is a compile-time constant, so the layouts fit on the stack
+    std::array<VkDescriptorSetLayout, framesInFlight> layouts;
+    layouts.fill(m_Pipeline->GetDescriptorSetLayout());
     m_DescriptorSets.resize(framesInFlight);
 
     VkDescriptorSetAllocateInfo allocInfo{};
@@ -207,12 +230,16 @@ void RenderSystem::CreateDescriptorSets() {
 }
 
 void RenderSystem::SetupEntityBuffers(Entity entity) {
-    MeshComponent* mesh = m_World->GetComponent<MeshComponent>(entity);
+    const World& world = *m_World; // Read-only access doesn't mark components changed
+    const MeshComponent* mesh = world.GetComponent<MeshComponent>(entity);
     if (!mesh || !mesh->IsValid()) {
         return;
     }
 
     EntityRenderData& renderData = m_EntityRenderData[entity];
+    if (const TransformComponent* transform = world.GetComponent<TransformComponent>(entity)) {
+        renderData.model = transform->ToMatrix();
+    }
 
     // Create vertex buffer
     usize vertexBufferSize = mesh->vertices.size() * sizeof(MeshComponent::Vertex);
@@ -243,9 +270,8 @@ void RenderSystem::SetupEntityBuffers(Entity entity) {
     renderData.indexCount = static_cast<u32>(mesh->indices.size());
 }
 
-void RenderSystem::UpdateUniformBuffer(Entity entity) {
-    TransformComponent* transform = m_World->GetComponent<TransformComponent>(entity);
-    if (!transform || !m_Camera) {
+void RenderSystem::UpdateUniformBuffer(const Math::Matrix4& model) {
+    if (!m_Camera) {
         return;
     }
 
@@ -254,7 +280,7 @@ void RenderSystem::UpdateUniformBuffer(Entity entity) {
     currentFrame = (currentFrame + 1) % static_cast<u32>(m_UniformBuffers.size());
 
     Renderer::UniformBufferObject ubo{};
-    ubo.model = transform->ToMatrix();
+    ubo.model = model;
     ubo.view = m_Camera->GetViewMatrix();
     ubo.proj = m_Camera->GetProjectionMatrix();
 
@@ -282,15 +308,8 @@ void RenderSystem::CreateTriangleMesh() {
     ENJIN_LOG_INFO(Renderer, "Created triangle entity: %llu", m_TriangleEntity);
 }
 
-void RenderSystem::RenderEntity(Entity entity) {
-    if (!m_Pipeline || !m_Renderer) {
-        return;
-    }
-
-    TransformComponent* transform = m_World->GetComponent<TransformComponent>(entity);
-    MeshComponent* mesh = m_World->GetComponent<MeshComponent>(entity);
-    
-    if (!transform || !mesh || !mesh->IsValid()) {
+void RenderSystem::RenderEntity(Entity entity, const MeshComponent& mesh) {
+    if (!m_Pipeline || !m_Renderer || !mesh.IsValid()) {
         return;
     }
 
@@ -312,7 +331,8 @@ void RenderSystem::RenderEntity(Entity entity) {
     }
 
     // Update uniform buffer
-    UpdateUniformBuffer(entity);
+    const Math::Matrix4* worldMatrix = m_Transforms ? m_Transforms->GetWorldMatrix(entity) : nullptr;
+    UpdateUniformBuffer(worldMatrix ? *worldMatrix : renderData.model);
 
     // Get current frame index (simplified)
     static u32 currentFrame = 0;
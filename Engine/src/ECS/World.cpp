@@ -1,5 +1,11 @@
 #include "Enjin/ECS/World.h"
+#include "Enjin/ECS/CommandBuffer.h"
+#include "Enjin/ECS/Prefab.h"
+#include "Enjin/ECS/Components/Transform.h"
 #include "Enjin/Logging/Log.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
 
 /**
  * @file World.cpp
@@ -11,12 +17,39 @@
 namespace Enjin {
 namespace ECS {
 
-World::World() {
-    m_SystemManager = std::make_unique<SystemManager>();
+namespace {
+
+std::atomic<u64> s_NextWorldId{1};
+
+// Last buffer this thread used; ids are never reused, so a stale entry can't match
+struct CommandBufferCache {
+    u64 worldId = 0;
+    CommandBuffer* buffer = nullptr;
+};
+thread_local CommandBufferCache t_CommandBufferCache;
+
+} // namespace
+
+World::World(std::pmr::memory_resource* resource)
+    : World(StorageMode::SparseSet, resource) {
+}
+
+World::World(StorageMode mode, std::pmr::memory_resource* resource)
+    : m_Resource(resource), m_StorageMode(mode), m_EntityManager(resource), m_ComponentStorages(resource)
+    , m_ComponentMasks(resource), m_Archetypes(resource), m_Groups(resource), m_GroupByType(resource)
+    , m_Id(s_NextWorldId.fetch_add(1, std::memory_order_relaxed)), m_CommandBuffers(resource) {
+    m_SystemManager = std::make_unique<SystemManager>(m_ChangeTick);
 }
 
 World::~World() {
-    Clear();
+    Clear(); // Also discards unplayed commands
+    std::pmr::polymorphic_allocator<> allocator(m_Resource);
+    for (auto& [thread, buffer] : m_CommandBuffers) {
+        allocator.delete_object(buffer);
+    }
+    for (GroupData* group : m_Groups) {
+        allocator.delete_object(group);
+    }
 }
 
 Entity World::CreateEntity() {
@@ -28,26 +61,387 @@ void World::DestroyEntity(Entity entity) {
         return;
     }
 
-    m_SystemManager->OnEntityRemoved(entity);
+    const u32 index = GetEntityIndex(entity);
+    if (index < m_ComponentMasks.size() && !m_ComponentMasks[index].Empty()) {
+        const ComponentMask mask = m_ComponentMasks[index];
+        m_SystemManager->OnComponentsChanged(entity, mask, ComponentMask());
+        LeaveGroups(entity, mask);
 
-    // Remove components from all storages
-    for (auto& [typeId, storage] : m_ComponentStorages) {
-        storage->Remove(entity);
+        // Only the storages that hold one of its components
+        m_Archetypes.DestroyEntity(entity);
+        mask.ForEach([this, entity](ComponentTypeId typeId) {
+            if (StorageBase* storage = FindStorageBase(typeId)) {
+                storage->Remove(entity);
+            }
+        });
+        m_ComponentMasks[index] = ComponentMask();
     }
 
     m_EntityManager.DestroyEntity(entity);
 }
 
+void World::RestoreEntities(const SnapshotReader& reader) {
+    // Everything currently alive goes, as far as systems are concerned
+    const std::span<const u32> generations = m_EntityManager.GetGenerations();
+    for (usize index = 0; index < m_ComponentMasks.size() && index < generations.size(); ++index) {
+        const ComponentMask mask = m_ComponentMasks[index];
+        if (!mask.Empty()) {
+            m_SystemManager->OnComponentsChanged(MakeEntity(static_cast<u32>(index), generations[index]), mask, ComponentMask());
+        }
+    }
+
+    Clear();
+    m_EntityManager.Restore(reader.GetGenerations(), reader.GetFreeIndices());
+    m_ComponentMasks.reserve(m_EntityManager.GetIndexCount());
+}
+
+const ComponentMask& World::GetComponentMask(Entity entity) const {
+    static const ComponentMask s_Empty;
+    const u32 index = GetEntityIndex(entity);
+    return IsValid(entity) && index < m_ComponentMasks.size() ? m_ComponentMasks[index] : s_Empty;
+}
+
+void World::OnComponentAdded(Entity entity, ComponentTypeId typeId) {
+    const u32 index = GetEntityIndex(entity);
+    if (index >= m_ComponentMasks.size()) {
+        m_ComponentMasks.resize(static_cast<usize>(index) + 1);
+    }
+    const ComponentMask before = m_ComponentMasks[index];
+    m_ComponentMasks[index].Set(typeId);
+    GroupData* group = FindGroup(typeId);
+    if (group && m_ComponentMasks[index].ContainsAll(group->owned)) {
+        PackIntoGroup(*group, entity);
+    }
+    // Copied: a system may add components from the callback and grow the vector
+    const ComponentMask after = m_ComponentMasks[index];
+    m_SystemManager->OnComponentsChanged(entity, before, after);
+}
+
+void World::OnComponentsAdded(std::span<const Entity> entities, ComponentTypeId typeId) {
+    // Every handle is valid, so the entity table bounds every index
+    if (m_ComponentMasks.size() < m_EntityManager.GetIndexCount()) {
+        m_ComponentMasks.resize(m_EntityManager.GetIndexCount());
+    }
+    const bool notify = m_SystemManager->HasSystems();
+    GroupData* group = FindGroup(typeId);
+    for (Entity entity : entities) {
+        ENJIN_ASSERT(IsValid(entity), "AddComponents on a destroyed entity");
+        const u32 index = GetEntityIndex(entity);
+        if (m_ComponentMasks[index].Test(typeId)) {
+            continue;
+        }
+        const ComponentMask before = m_ComponentMasks[index];
+        m_ComponentMasks[index].Set(typeId);
+        if (group && m_ComponentMasks[index].ContainsAll(group->owned)) {
+            PackIntoGroup(*group, entity);
+        }
+        if (notify) {
+            const ComponentMask after = m_ComponentMasks[index]; // Callbacks may grow the vector
+            m_SystemManager->OnComponentsChanged(entity, before, after);
+        }
+    }
+}
+
+void World::OnComponentRemoving(Entity entity, ComponentTypeId typeId) {
+    const u32 index = GetEntityIndex(entity);
+    ENJIN_ASSERT(index < m_ComponentMasks.size(), "Removing a component the mask doesn't know about");
+    const ComponentMask before = m_ComponentMasks[index];
+    ComponentMask after = before;
+    after.Reset(typeId);
+    m_SystemManager->OnComponentsChanged(entity, before, after);
+    GroupData* group = FindGroup(typeId);
+    if (group && m_ComponentMasks[index].ContainsAll(group->owned)) {
+        UnpackFromGroup(*group, entity);
+    }
+    m_ComponentMasks[index].Reset(typeId);
+}
+
+void World::OnEntitiesSpawned(std::span<const Entity> entities, const ComponentMask& mask) {
+    if (mask.Empty()) {
+        return;
+    }
+    if (m_ComponentMasks.size() < m_EntityManager.GetIndexCount()) {
+        m_ComponentMasks.resize(m_EntityManager.GetIndexCount());
+    }
+    pmr::Vector<GroupData*> groups(m_Resource);
+    for (GroupData* group : m_Groups) {
+        if (mask.ContainsAll(group->owned)) {
+            groups.push_back(group);
+        }
+    }
+    const bool notify = m_SystemManager->HasSystems();
+    for (Entity entity : entities) {
+        m_ComponentMasks[GetEntityIndex(entity)] = mask;
+        for (GroupData* group : groups) {
+            PackIntoGroup(*group, entity);
+        }
+        if (notify) {
+            m_SystemManager->OnComponentsChanged(entity, ComponentMask(), mask);
+        }
+    }
+}
+
+World::GroupData* World::AcquireGroup(const ComponentMask& owned) {
+    bool conflict = false;
+    for (GroupData* group : m_Groups) {
+        if (group->owned == owned) {
+            return group;
+        }
+        conflict = conflict || group->owned.Intersects(owned);
+    }
+    if (conflict) {
+        ENJIN_LOG_ERROR(Core, "Group requested over a component already owned by another group; iterating it as a view");
+        return nullptr;
+    }
+
+    std::pmr::polymorphic_allocator<> allocator(m_Resource);
+    GroupData* group = allocator.new_object<GroupData>();
+    group->owned = owned;
+    m_Groups.push_back(group);
+    owned.ForEach([this, group](ComponentTypeId typeId) {
+        if (typeId >= m_GroupByType.size()) {
+            m_GroupByType.resize(static_cast<usize>(typeId) + 1, nullptr);
+        }
+        m_GroupByType[typeId] = group;
+    });
+
+    // Walk the smallest storage; everything before position i is settled,
+    // so packing only ever swaps the current entity backwards
+    StorageBase* lead = nullptr;
+    owned.ForEach([this, &lead](ComponentTypeId typeId) {
+        StorageBase* storage = FindStorageBase(typeId);
+        if (!lead || storage->Size() < lead->Size()) {
+            lead = storage;
+        }
+    });
+    for (u32 i = 0; i < lead->Size(); ++i) {
+        const Entity entity = lead->GetEntity(i);
+        if (m_ComponentMasks[GetEntityIndex(entity)].ContainsAll(owned)) {
+            PackIntoGroup(*group, entity);
+        }
+    }
+    return group;
+}
+
+void World::PackIntoGroup(GroupData& group, Entity entity) {
+    const u32 position = static_cast<u32>(group.size++);
+    group.owned.ForEach([this, entity, position](ComponentTypeId typeId) {
+        StorageBase* storage = FindStorageBase(typeId);
+        storage->Swap(storage->GetIndex(entity), position);
+    });
+}
+
+void World::UnpackFromGroup(GroupData& group, Entity entity) {
+    const u32 position = static_cast<u32>(--group.size);
+    group.owned.ForEach([this, entity, position](ComponentTypeId typeId) {
+        StorageBase* storage = FindStorageBase(typeId);
+        storage->Swap(storage->GetIndex(entity), position);
+    });
+}
+
+void World::LeaveGroups(Entity entity, const ComponentMask& mask) {
+    for (GroupData* group : m_Groups) {
+        if (mask.ContainsAll(group->owned)) {
+            UnpackFromGroup(*group, entity);
+        }
+    }
+}
+
+void World::CreateEntities(std::span<Entity> entities) {
+    m_EntityManager.CreateEntities(entities);
+    m_ComponentMasks.reserve(m_EntityManager.GetIndexCount());
+}
+
+void World::DestroyEntities(std::span<const Entity> entities) {
+    pmr::Vector<Entity> destroyed(m_Resource);
+    destroyed.reserve(entities.size());
+    ComponentMask touched;
+
+    for (Entity entity : entities) {
+        if (!m_EntityManager.IsValid(entity)) {
+            continue;
+        }
+        const u32 index = GetEntityIndex(entity);
+        if (index < m_ComponentMasks.size() && !m_ComponentMasks[index].Empty()) {
+            const ComponentMask mask = m_ComponentMasks[index];
+            m_SystemManager->OnComponentsChanged(entity, mask, ComponentMask());
+            LeaveGroups(entity, mask);
+            touched |= mask;
+            m_ComponentMasks[index] = ComponentMask(); // A repeated handle isn't notified again
+        }
+        destroyed.push_back(entity);
+    }
+
+    if (m_StorageMode == StorageMode::Archetype) {
+        for (Entity entity : destroyed) {
+            m_Archetypes.DestroyEntity(entity);
+        }
+    } else {
+        touched.ForEach([this, &destroyed](ComponentTypeId typeId) {
+            if (StorageBase* storage = FindStorageBase(typeId)) {
+                storage->Remove(destroyed);
+            }
+        });
+    }
+
+    for (Entity entity : destroyed) {
+        m_EntityManager.DestroyEntity(entity);
+    }
+}
+
+void World::Instantiate(const Prefab& prefab, std::span<Entity> entities, std::span<const TransformComponent> transforms) {
+    ENJIN_ASSERT((transforms.empty() || transforms.size() == entities.size()), "Instantiate needs one transform per instance, or none");
+    MemoryTagScope memoryTag(MemoryTag::ECS);
+    CreateEntities(entities);
+    if (entities.empty()) {
+        return;
+    }
+
+    const ChangeTick tick = GetChangeTick();
+    const ComponentTypeInfo& transformInfo = ComponentRegistry::GetTypeInfo<TransformComponent>();
+    const bool placed = transforms.size() == entities.size();
+    ComponentMask mask = prefab.GetMask();
+    if (placed) {
+        mask.Set(transformInfo.id);
+    }
+
+    if (m_StorageMode == StorageMode::Archetype) {
+        // Sorted by id, as ForEach visits them
+        pmr::Vector<const ComponentTypeInfo*> types(m_Resource);
+        mask.ForEach([&](ComponentTypeId typeId) {
+            if (placed && typeId == transformInfo.id) {
+                types.push_back(&transformInfo);
+                return;
+            }
+            for (const Prefab::Column& column : prefab.GetColumns()) {
+                if (column.info->id == typeId) {
+                    types.push_back(column.info);
+                    break;
+                }
+            }
+        });
+
+        Archetype* archetype = m_Archetypes.AddEntities(entities, types, tick);
+        if (!archetype) {
+            return; // Empty prefab
+        }
+        const usize capacity = archetype->GetChunkCapacity();
+        const usize first = archetype->GetEntityCount() - entities.size();
+        const usize end = archetype->GetEntityCount();
+        // Calls func(row, count) for each run of new rows within one chunk
+        auto forEachRun = [&](auto&& func) {
+            for (usize row = first; row < end;) {
+                const usize count = std::min(end, (row / capacity + 1) * capacity) - row;
+                func(row, count);
+                row += count;
+            }
+        };
+
+        for (const Prefab::Column& column : prefab.GetColumns()) {
+            if (placed && column.info->id == transformInfo.id) {
+                continue;
+            }
+            const i32 index = archetype->GetColumnIndex(column.info->id);
+            const void* value = prefab.GetValue(column);
+            forEachRun([&](usize row, usize count) {
+                column.fill(archetype->GetComponent(row, index), value, count);
+            });
+        }
+        if (placed) {
+            const i32 index = archetype->GetColumnIndex(transformInfo.id);
+            forEachRun([&](usize row, usize count) {
+                std::uninitialized_copy_n(transforms.data() + (row - first), count,
+                                          static_cast<TransformComponent*>(archetype->GetComponent(row, index)));
+            });
+        }
+    } else {
+        for (const Prefab::Column& column : prefab.GetColumns()) {
+            if (!(placed && column.info->id == transformInfo.id)) {
+                column.append(*this, entities, prefab.GetValue(column), tick);
+            }
+        }
+        if (placed) {
+            GetOrCreateStorage<TransformComponent>()->Add(entities, transforms, tick);
+        }
+    }
+
+    OnEntitiesSpawned(entities, mask);
+}
+
+Entity World::Instantiate(const Prefab& prefab) {
+    Entity entity = INVALID_ENTITY;
+    Instantiate(prefab, std::span<Entity>(&entity, 1));
+    return entity;
+}
+
 bool World::IsValid(Entity entity) const {
     return m_EntityManager.IsValid(entity);
 }
 
 void World::Update(f32 deltaTime) {
     m_SystemManager->Update(deltaTime);
+    FlushCommandBuffers();
+}
+
+CommandBuffer& World::GetCommandBuffer() {
+    CommandBufferCache& cache = t_CommandBufferCache;
+    if (cache.worldId == m_Id) {
+        return *cache.buffer;
+    }
+
+    const std::thread::id thread = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(m_CommandBufferMutex);
+    CommandBuffer* buffer = nullptr;
+    for (auto& [owner, candidate] : m_CommandBuffers) {
+        if (owner == thread) {
+            buffer = candidate;
+            break;
+        }
+    }
+    if (!buffer) {
+        std::pmr::polymorphic_allocator<> allocator(m_Resource);
+        buffer = allocator.new_object<CommandBuffer>(*this);
+        m_CommandBuffers.emplace_back(thread, buffer);
+    }
+    cache = { m_Id, buffer };
+    return *buffer;
+}
+
+void World::FlushCommandBuffers() {
+    pmr::Vector<CommandBuffer*> pending(m_Resource);
+    {
+        std::lock_guard<std::mutex> lock(m_CommandBufferMutex);
+        for (auto& [thread, buffer] : m_CommandBuffers) {
+            if (!buffer->Empty()) {
+                pending.push_back(buffer);
+            }
+        }
+    }
+    if (!pending.empty()) {
+        CommandBuffer::Playback(*this, pending);
+    }
 }
 
 void World::Clear() {
+    {
+        std::lock_guard<std::mutex> lock(m_CommandBufferMutex);
+        for (auto& [thread, buffer] : m_CommandBuffers) {
+            buffer->Clear();
+        }
+    }
+
+    std::pmr::polymorphic_allocator<> allocator(m_Resource);
+    for (StorageBase* storage : m_ComponentStorages) {
+        if (storage) {
+            storage->Destroy(allocator);
+        }
+    }
     m_ComponentStorages.clear();
+    m_ComponentMasks.clear();
+    for (GroupData* group : m_Groups) {
+        group->size = 0; // Groups outlive their contents
+    }
+    m_Archetypes.Clear();
     m_EntityManager.Reset();
 }
 
@@ -1,12 +1,14 @@
 #include "Enjin/Physics/PhysicsWorld.h"
 #include "Enjin/Logging/Log.h"
 #include "Enjin/Math/Math.h"
+#include "Enjin/Memory/MemoryTracker.h"
 #include <algorithm>
 
 namespace Enjin {
 namespace Physics {
 
-PhysicsWorld::PhysicsWorld() {
+PhysicsWorld::PhysicsWorld(std::pmr::memory_resource* resource)
+    : m_RigidBodies(resource) {
 }
 
 PhysicsWorld::~PhysicsWorld() {
@@ -28,6 +30,7 @@ void PhysicsWorld::SetGravity(const Math::Vector3& gravity) {
 
 void PhysicsWorld::AddRigidBody(std::shared_ptr<RigidBody> body) {
     if (body) {
+        MemoryTagScope memoryTag(MemoryTag::Physics);
         m_RigidBodies.push_back(body);
     }
 }
@@ -40,6 +43,7 @@ void PhysicsWorld::RemoveRigidBody(std::shared_ptr<RigidBody> body) {
 }
 
 void PhysicsWorld::Step(f32 deltaTime) {
+    MemoryTagScope memoryTag(MemoryTag::Physics);
     // Simple physics step
     Integrate(deltaTime);
     DetectCollisions();
@@ -146,7 +146,8 @@ void MaterialInstance::UpdateUniforms(VkCommandBuffer cmd, u32 frameIndex) {
     }
 }
 
-MaterialSystem::MaterialSystem() {
+MaterialSystem::MaterialSystem(std::pmr::memory_resource* resource)
+    : m_Materials(resource), m_MaterialNameMap(resource) {
 }
 
 MaterialSystem::~MaterialSystem() {
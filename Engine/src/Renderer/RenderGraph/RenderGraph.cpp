@@ -1,6 +1,7 @@
 #include "Enjin/Renderer/RenderGraph/RenderGraph.h"
 #include "Enjin/Logging/Log.h"
 #include "Enjin/Core/Assert.h"
+#include "Enjin/Memory/FrameAllocator.h"
 #include <algorithm>
 #include <queue>
 
@@ -8,8 +9,14 @@ namespace Enjin {
 namespace Renderer {
 
 // RenderPassNode implementation
-RenderPassNode::RenderPassNode(const std::string& name)
-    : m_Name(name) {
+RenderPassNode::RenderPassNode(std::string_view name, std::pmr::memory_resource* resource)
+    : m_Name(name, resource)
+    , m_Inputs(resource)
+    , m_Outputs(resource)
+    , m_SampledImages(resource)
+    , m_StorageImages(resource)
+    , m_UniformBuffers(resource)
+    , m_StorageBuffers(resource) {
 }
 
 void RenderPassNode::AddColorInput(ResourceHandle handle) {
@@ -55,8 +62,8 @@ void RenderPassNode::Execute(VkCommandBuffer cmd) const {
 }
 
 // ResourceNode implementation
-ResourceNode::ResourceNode(const std::string& name, ResourceType type)
-    : m_Name(name), m_Type(type) {
+ResourceNode::ResourceNode(std::string_view name, ResourceType type, std::pmr::memory_resource* resource)
+    : m_Name(name, resource), m_Type(type) {
 }
 
 void ResourceNode::SetImage(VkImage image, VkFormat format, u32 width, u32 height) {
@@ -72,8 +79,13 @@ void ResourceNode::SetBuffer(VkBuffer buffer, VkDeviceSize size) {
 }
 
 // RenderGraph implementation
-RenderGraph::RenderGraph(VulkanContext* context)
-    : m_Context(context) {
+RenderGraph::RenderGraph(VulkanContext* context, std::pmr::memory_resource* resource)
+    : m_Context(context)
+    , m_Allocator(resource)
+    , m_Resources(resource)
+    , m_Passes(resource)
+    , m_ResourceNameMap(resource)
+    , m_OrderedPasses(resource) {
     ENJIN_LOG_INFO(Renderer, "RenderGraph created");
 }
 
@@ -83,10 +95,10 @@ RenderGraph::~RenderGraph() {
 
 ResourceHandle RenderGraph::AddResource(const std::string& name, ResourceType type) {
     ResourceHandle handle = static_cast<ResourceHandle>(m_Resources.size());
-    auto resource = std::make_unique<ResourceNode>(name, type);
+    ResourceNode* resource = m_Allocator.new_object<ResourceNode>(name, type, m_Allocator.resource());
     resource->SetHandle(handle);
-    m_Resources.push_back(std::move(resource));
-    m_ResourceNameMap[name] = handle;
+    m_Resources.push_back(resource);
+    m_ResourceNameMap.insert_or_assign(resource->GetName(), handle);
     return handle;
 }
 
@@ -94,14 +106,13 @@ ResourceNode* RenderGraph::GetResource(ResourceHandle handle) {
     if (handle >= m_Resources.size()) {
         return nullptr;
     }
-    return m_Resources[handle].get();
+    return m_Resources[handle];
 }
 
 RenderPassNode* RenderGraph::AddRenderPass(const std::string& name) {
-    auto pass = std::make_unique<RenderPassNode>(name);
-    RenderPassNode* passPtr = pass.get();
-    m_Passes.push_back(std::move(pass));
-    return passPtr;
+    RenderPassNode* pass = m_Allocator.new_object<RenderPassNode>(name, m_Allocator.resource());
+    m_Passes.push_back(pass);
+    return pass;
 }
 
 bool RenderGraph::Build() {
@@ -128,6 +139,12 @@ void RenderGraph::Execute(VkCommandBuffer cmd) {
 }
 
 void RenderGraph::Clear() {
+    for (ResourceNode* resource : m_Resources) {
+        m_Allocator.delete_object(resource);
+    }
+    for (RenderPassNode* pass : m_Passes) {
+        m_Allocator.delete_object(pass);
+    }
     m_Resources.clear();
     m_Passes.clear();
     m_ResourceNameMap.clear();
@@ -136,7 +153,7 @@ void RenderGraph::Clear() {
 }
 
 ResourceHandle RenderGraph::GetResourceHandle(const std::string& name) const {
-    auto it = m_ResourceNameMap.find(name);
+    auto it = m_ResourceNameMap.find(std::string_view(name));
     if (it != m_ResourceNameMap.end()) {
         return it->second;
     }
@@ -164,8 +181,8 @@ void RenderGraph::TopologicalSort() {
     
     // For now, just use insertion order
     // Full implementation would sort based on dependencies
-    for (auto& pass : m_Passes) {
-        m_OrderedPasses.push_back(pass.get());
+    for (RenderPassNode* pass : m_Passes) {
+        m_OrderedPasses.push_back(pass);
     }
     
     // Assign order
@@ -174,10 +191,34 @@ void RenderGraph::TopologicalSort() {
     }
 }
 
+// Per-frame scratch array; falls back to the caller's vector outside an Application
+template<typename T>
+static T* AllocateScratch(std::vector<T>& fallback, usize count) {
+    if (FrameAllocator* frame = GetFrameAllocator()) {
+        if (T* scratch = frame->AllocateArray<T>(count)) {
+            return scratch;
+        }
+    }
+    fallback.resize(count);
+    return fallback.data();
+}
+
 void RenderGraph::InsertBarriers(VkCommandBuffer cmd, RenderPassNode* pass) {
-    // Insert memory barriers for resources used by this pass
-    std::vector<VkImageMemoryBarrier> imageBarriers;
-    std::vector<VkBufferMemoryBarrier> bufferBarriers;
+    // Insert memory barriers for resources used by this pass.
+    // Each resource needs at most one barrier, which bounds the scratch arrays.
+    const usize maxImageBarriers = pass->GetInputs().size() + pass->GetOutputs().size() +
+                                   pass->GetSampledImages().size() + pass->GetStorageImages().size();
+    const usize maxBufferBarriers = pass->GetUniformBuffers().size() + pass->GetStorageBuffers().size();
+    if (maxImageBarriers == 0 && maxBufferBarriers == 0) {
+        return;
+    }
+
+    std::vector<VkImageMemoryBarrier> imageFallback;
+    std::vector<VkBufferMemoryBarrier> bufferFallback;
+    VkImageMemoryBarrier* imageBarriers = AllocateScratch(imageFallback, maxImageBarriers);
+    VkBufferMemoryBarrier* bufferBarriers = AllocateScratch(bufferFallback, maxBufferBarriers);
+    u32 imageBarrierCount = 0;
+    u32 bufferBarrierCount = 0;
     
     // Process color/depth attachments
     for (ResourceHandle handle : pass->GetInputs()) {
@@ -186,7 +227,7 @@ void RenderGraph::InsertBarriers(VkCommandBuffer cmd, RenderPassNode* pass) {
         
         ResourceState newState = GetRequiredState(ResourceUsage::ColorAttachment, true);
         if (resource->GetCurrentState().imageLayout != newState.imageLayout) {
-            imageBarriers.push_back(CreateImageBarrier(resource, resource->GetCurrentState(), newState));
+            imageBarriers[imageBarrierCount++] = CreateImageBarrier(resource, resource->GetCurrentState(), newState);
             resource->SetCurrentState(newState);
         }
     }
@@ -197,7 +238,7 @@ void RenderGraph::InsertBarriers(VkCommandBuffer cmd, RenderPassNode* pass) {
         
         ResourceState newState = GetRequiredState(ResourceUsage::ColorAttachment, false);
         if (resource->GetCurrentState().imageLayout != newState.imageLayout) {
-            imageBarriers.push_back(CreateImageBarrier(resource, resource->GetCurrentState(), newState));
+            imageBarriers[imageBarrierCount++] = CreateImageBarrier(resource, resource->GetCurrentState(), newState);
             resource->SetCurrentState(newState);
         }
     }
@@ -209,7 +250,7 @@ void RenderGraph::InsertBarriers(VkCommandBuffer cmd, RenderPassNode* pass) {
         
         ResourceState newState = GetRequiredState(ResourceUsage::SampledImage, true);
         if (resource->GetCurrentState().imageLayout != newState.imageLayout) {
-            imageBarriers.push_back(CreateImageBarrier(resource, resource->GetCurrentState(), newState));
+            imageBarriers[imageBarrierCount++] = CreateImageBarrier(resource, resource->GetCurrentState(), newState);
             resource->SetCurrentState(newState);
         }
     }
@@ -221,7 +262,7 @@ void RenderGraph::InsertBarriers(VkCommandBuffer cmd, RenderPassNode* pass) {
         
         ResourceState newState = GetRequiredState(ResourceUsage::StorageImage, false);
         if (resource->GetCurrentState().imageLayout != newState.imageLayout) {
-            imageBarriers.push_back(CreateImageBarrier(resource, resource->GetCurrentState(), newState));
+            imageBarriers[imageBarrierCount++] = CreateImageBarrier(resource, resource->GetCurrentState(), newState);
             resource->SetCurrentState(newState);
         }
     }
@@ -233,13 +274,13 @@ void RenderGraph::InsertBarriers(VkCommandBuffer cmd, RenderPassNode* pass) {
         
         ResourceState newState = GetRequiredState(ResourceUsage::UniformBuffer, true);
         if (resource->GetCurrentState().accessFlags != newState.accessFlags) {
-            bufferBarriers.push_back(CreateBufferBarrier(resource, resource->GetCurrentState(), newState));
+            bufferBarriers[bufferBarrierCount++] = CreateBufferBarrier(resource, resource->GetCurrentState(), newState);
             resource->SetCurrentState(newState);
         }
     }
     
     // Submit barriers
-    if (!imageBarriers.empty() || !bufferBarriers.empty()) {
+    if (imageBarrierCount > 0 || bufferBarrierCount > 0) {
         VkPipelineStageFlags srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
         VkPipelineStageFlags dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
         
@@ -249,8 +290,8 @@ void RenderGraph::InsertBarriers(VkCommandBuffer cmd, RenderPassNode* pass) {
             dstStage,
             0,
             0, nullptr,
-            static_cast<u32>(bufferBarriers.size()), bufferBarriers.data(),
-            static_cast<u32>(imageBarriers.size()), imageBarriers.data()
+            bufferBarrierCount, bufferBarriers,
+            imageBarrierCount, imageBarriers
         );
     }
 }
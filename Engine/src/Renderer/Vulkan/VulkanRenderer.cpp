@@ -1,6 +1,7 @@
 #include "Enjin/Renderer/Vulkan/VulkanRenderer.h"
 #include "Enjin/Logging/Log.h"
 #include "Enjin/Core/Assert.h"
+#include "Enjin/Memory/MemoryTracker.h"
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
 #include <array>
@@ -23,6 +24,7 @@ VulkanRenderer::~VulkanRenderer() {
 }
 
 bool VulkanRenderer::Initialize(Window* window) {
+    MemoryTagScope memoryTag(MemoryTag::Renderer);
     m_Window = window;
     ENJIN_LOG_INFO(Renderer, "Initializing Vulkan renderer...");
 
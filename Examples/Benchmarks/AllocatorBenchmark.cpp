@@ -0,0 +1,108 @@
+#include "Enjin/Memory/Memory.h"
+#include "Enjin/Memory/ThreadCachingAllocator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+/**
+ * @file AllocatorBenchmark.cpp
+ * @brief Multi-threaded small-object alloc/free benchmark: ThreadCachingAllocator vs system malloc
+ *
+ * Each thread keeps a ring of live blocks with engine-like sizes (8-512 bytes,
+ * skewed small) and replaces one block per iteration, so every iteration is
+ * one free plus one allocation. Run with an optional thread cap:
+ *   BenchmarkAllocator [maxThreads]
+ */
+
+using namespace Enjin;
+
+namespace {
+
+constexpr usize OPERATIONS_PER_THREAD = 2'000'000;
+constexpr usize LIVE_BLOCKS = 1024;
+
+struct EnjinBackend {
+    static void* Alloc(usize size) { return ThreadCachingAllocator::Get().Allocate(size); }
+    static void  Free(void* ptr) { ThreadCachingAllocator::Get().Deallocate(ptr); }
+};
+
+struct MallocBackend {
+    static void* Alloc(usize size) { return std::malloc(size); }
+    static void  Free(void* ptr) { std::free(ptr); }
+};
+
+// xorshift - cheap enough not to dominate the measurement
+inline u32 NextRandom(u32& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+template<typename Backend>
+void Worker(u32 seed, std::atomic<bool>& start) {
+    void* blocks[LIVE_BLOCKS] = {};
+    u32 rng = seed * 2654435761u + 1;
+
+    while (!start.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+
+    for (usize i = 0; i < OPERATIONS_PER_THREAD; ++i) {
+        u32 r = NextRandom(rng);
+        usize slot = r % LIVE_BLOCKS;
+        // Mostly tiny (strings, function objects, map nodes), occasionally larger
+        usize size = (r >> 12) % 8 == 0 ? 64 + (r >> 16) % 448 : 8 + (r >> 16) % 56;
+        Backend::Free(blocks[slot]);
+        blocks[slot] = Backend::Alloc(size);
+        static_cast<u8*>(blocks[slot])[0] = static_cast<u8>(i);
+    }
+
+    for (void* block : blocks) {
+        Backend::Free(block);
+    }
+}
+
+template<typename Backend>
+f64 Run(u32 threadCount) {
+    std::atomic<bool> start{false};
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (u32 t = 0; t < threadCount; ++t) {
+        threads.emplace_back(Worker<Backend>, t + 1, std::ref(start));
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    f64 seconds = std::chrono::duration<f64>(end - begin).count();
+    return static_cast<f64>(OPERATIONS_PER_THREAD * threadCount) / seconds / 1.0e6;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    u32 maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    if (argc > 1) {
+        maxThreads = std::max(1, std::atoi(argv[1]));
+    }
+
+    std::printf("%8s %16s %16s %8s\n", "threads", "enjin Mops/s", "malloc Mops/s", "speedup");
+    for (u32 threads = 1; threads <= maxThreads; threads *= 2) {
+        f64 enjin = Run<EnjinBackend>(threads);
+        f64 system = Run<MallocBackend>(threads);
+        std::printf("%8u %16.1f %16.1f %7.2fx\n", threads, enjin, system, enjin / system);
+        if (threads < maxThreads && threads * 2 > maxThreads) {
+            threads = maxThreads / 2; // Always finish on the full thread count
+        }
+    }
+    return 0;
+}
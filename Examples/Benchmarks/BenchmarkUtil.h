@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Enjin/Platform/Types.h"
+#include <chrono>
+
+/**
+ * @file BenchmarkUtil.h
+ * @brief Helpers shared by the benchmark executables
+ * @author Enjin Engine Team
+ * @date 2025
+ */
+
+namespace Enjin {
+namespace Benchmark {
+
+// Wall-clock time since construction
+struct Timer {
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+    f64 Milliseconds() const {
+        return std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    // Average per operation over the elapsed time
+    f64 Nanoseconds(usize operations) const {
+        const f64 elapsed = std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - begin).count();
+        return elapsed / static_cast<f64>(operations);
+    }
+};
+
+} // namespace Benchmark
+} // namespace Enjin
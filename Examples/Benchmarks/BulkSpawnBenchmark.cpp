@@ -0,0 +1,112 @@
+#include "Enjin/ECS/World.h"
+#include "Enjin/ECS/Components/Transform.h"
+#include "BenchmarkUtil.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * @file BulkSpawnBenchmark.cpp
+ * @brief Spawning and destroying a particle burst one entity at a time vs in bulk
+ *
+ * Each particle gets a TransformComponent and a trivially copyable Particle.
+ * "single" uses CreateEntity/AddComponent/DestroyEntity per entity, "bulk"
+ * CreateEntities/AddComponents/DestroyEntities. Four systems are registered
+ * so notifications are part of the cost. Run with an optional count:
+ *   BenchmarkBulkSpawn [entities]
+ */
+
+using namespace Enjin;
+using namespace Enjin::ECS;
+
+namespace {
+
+constexpr u32 ROUNDS = 10;
+
+struct Particle {
+    Math::Vector3 velocity;
+    f32 life = 1.0f;
+    u32 color = 0xFFFFFFFFu;
+};
+
+struct IdleSystem : ISystem {
+    void Update(f32) override {}
+};
+
+using Benchmark::Timer;
+
+struct Results {
+    f64 spawn = 0.0;   // ms per burst
+    f64 destroy = 0.0; // ms per burst
+    usize alive = 0;
+};
+
+Results Run(StorageMode mode, usize count, bool bulk) {
+    World world(mode);
+    for (u32 i = 0; i < 4; ++i) {
+        world.RegisterSystem<IdleSystem>();
+    }
+
+    std::vector<Particle> particles(count);
+    for (usize i = 0; i < count; ++i) {
+        particles[i].velocity = Math::Vector3(0.0f, 1.0f + static_cast<f32>(i % 13), 0.0f);
+    }
+    std::vector<Entity> entities(count);
+
+    Results results;
+    for (u32 round = 0; round < ROUNDS; ++round) {
+        Timer spawn;
+        if (bulk) {
+            world.CreateEntities(entities);
+            world.AddComponents<TransformComponent>(entities);
+            world.AddComponents<Particle>(entities, particles);
+        } else {
+            for (usize i = 0; i < count; ++i) {
+                entities[i] = world.CreateEntity();
+                world.AddComponent<TransformComponent>(entities[i]);
+                world.AddComponent<Particle>(entities[i], particles[i]);
+            }
+        }
+        results.spawn += spawn.Milliseconds();
+        results.alive = world.GetEntityCount();
+
+        Timer destroy;
+        if (bulk) {
+            world.DestroyEntities(entities);
+        } else {
+            for (Entity entity : entities) {
+                world.DestroyEntity(entity);
+            }
+        }
+        results.destroy += destroy.Milliseconds();
+    }
+    results.spawn /= ROUNDS;
+    results.destroy /= ROUNDS;
+    return results;
+}
+
+void Print(const char* label, StorageMode mode, usize count) {
+    const Results single = Run(mode, count, false);
+    const Results bulk = Run(mode, count, true);
+    std::printf("%10s %8s %10.2f %10.2f %7.2fx\n", label, "spawn", single.spawn, bulk.spawn, single.spawn / bulk.spawn);
+    std::printf("%10s %8s %10.2f %10.2f %7.2fx\n", "", "destroy", single.destroy, bulk.destroy, single.destroy / bulk.destroy);
+    if (single.alive != count || bulk.alive != count) {
+        std::printf("entity count mismatch: %zu / %zu\n", single.alive, bulk.alive);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    usize count = 100'000;
+    if (argc > 1) {
+        count = static_cast<usize>(std::max(1, std::atoi(argv[1])));
+    }
+
+    std::printf("%zu entities per burst (ms)\n", count);
+    std::printf("%10s %8s %10s %10s %8s\n", "", "", "single", "bulk", "speedup");
+    Print("SparseSet", StorageMode::SparseSet, count);
+    Print("Archetype", StorageMode::Archetype, count);
+    return 0;
+}
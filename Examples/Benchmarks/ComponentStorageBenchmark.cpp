@@ -0,0 +1,145 @@
+#include "Enjin/ECS/Component.h"
+#include "Enjin/ECS/Components/Transform.h"
+#include "BenchmarkUtil.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file ComponentStorageBenchmark.cpp
+ * @brief Paged sparse-set ComponentStorage vs the previous hash-map storage
+ *
+ * Adds a TransformComponent to N entities, then times random-order Get,
+ * a dense iteration pass and random-order Remove. Run with an optional count:
+ *   BenchmarkComponentStorage [entities]
+ */
+
+using namespace Enjin;
+using namespace Enjin::ECS;
+
+namespace {
+
+// The storage ComponentStorage used before: dense arrays plus an
+// unordered_map from entity to dense index
+template<typename T>
+class HashComponentStorage {
+public:
+    T& Add(Entity entity) {
+        m_Entities.push_back(entity);
+        m_Components.push_back(T{});
+        m_EntityToIndex[entity] = m_Components.size() - 1;
+        return m_Components.back();
+    }
+
+    void Remove(Entity entity) {
+        auto it = m_EntityToIndex.find(entity);
+        if (it == m_EntityToIndex.end()) {
+            return;
+        }
+        usize index = it->second;
+        usize lastIndex = m_Components.size() - 1;
+        if (index != lastIndex) {
+            m_Components[index] = std::move(m_Components[lastIndex]);
+            m_Entities[index] = m_Entities[lastIndex];
+            m_EntityToIndex[m_Entities[index]] = index;
+        }
+        m_Components.pop_back();
+        m_Entities.pop_back();
+        m_EntityToIndex.erase(it);
+    }
+
+    T* Get(Entity entity) {
+        auto it = m_EntityToIndex.find(entity);
+        return it == m_EntityToIndex.end() ? nullptr : &m_Components[it->second];
+    }
+
+    std::vector<T>& GetComponents() { return m_Components; }
+
+private:
+    std::vector<Entity> m_Entities;
+    std::vector<T> m_Components;
+    std::unordered_map<Entity, usize> m_EntityToIndex;
+};
+
+using Benchmark::Timer;
+
+struct Results {
+    f64 add = 0.0;
+    f64 get = 0.0;
+    f64 iterate = 0.0;
+    f64 remove = 0.0;
+    f32 checksum = 0.0f;
+};
+
+template<typename Storage>
+Results Run(const std::vector<Entity>& entities, const std::vector<Entity>& shuffled) {
+    Results results;
+    Storage storage;
+
+    Timer add;
+    for (Entity entity : entities) {
+        storage.Add(entity).position.x = static_cast<f32>(GetEntityIndex(entity));
+    }
+    results.add = add.Milliseconds();
+
+    Timer get;
+    for (Entity entity : shuffled) {
+        results.checksum += storage.Get(entity)->position.x;
+    }
+    results.get = get.Milliseconds();
+
+    Timer iterate;
+    for (TransformComponent& transform : storage.GetComponents()) {
+        transform.position.y += 1.0f;
+        results.checksum += transform.position.y;
+    }
+    results.iterate = iterate.Milliseconds();
+
+    Timer remove;
+    for (Entity entity : shuffled) {
+        storage.Remove(entity);
+    }
+    results.remove = remove.Milliseconds();
+    return results;
+}
+
+// xorshift for a reproducible shuffle
+inline u32 NextRandom(u32& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    usize count = 1'000'000;
+    if (argc > 1) {
+        count = static_cast<usize>(std::max(1, std::atoi(argv[1])));
+    }
+
+    std::vector<Entity> entities(count);
+    for (usize i = 0; i < count; ++i) {
+        entities[i] = MakeEntity(static_cast<u32>(i), 1);
+    }
+    std::vector<Entity> shuffled = entities;
+    u32 rng = 2463534242u;
+    for (usize i = shuffled.size() - 1; i > 0; --i) {
+        std::swap(shuffled[i], shuffled[NextRandom(rng) % (i + 1)]);
+    }
+
+    const Results sparse = Run<ComponentStorage<TransformComponent>>(entities, shuffled);
+    const Results hash = Run<HashComponentStorage<TransformComponent>>(entities, shuffled);
+
+    std::printf("%zu entities, TransformComponent (ms)\n", count);
+    std::printf("%10s %14s %14s %8s\n", "", "paged sparse", "unordered_map", "speedup");
+    std::printf("%10s %14.2f %14.2f %7.2fx\n", "Add", sparse.add, hash.add, hash.add / sparse.add);
+    std::printf("%10s %14.2f %14.2f %7.2fx\n", "Get", sparse.get, hash.get, hash.get / sparse.get);
+    std::printf("%10s %14.2f %14.2f %7.2fx\n", "iterate", sparse.iterate, hash.iterate, hash.iterate / sparse.iterate);
+    std::printf("%10s %14.2f %14.2f %7.2fx\n", "Remove", sparse.remove, hash.remove, hash.remove / sparse.remove);
+    std::printf("(checksum %.0f / %.0f)\n", sparse.checksum, hash.checksum);
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "Enjin/ECS/World.h"
+#include "Enjin/ECS/Components/Transform.h"
+#include "BenchmarkUtil.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * @file ECSBenchmark.cpp
+ * @brief World storage modes compared on a scene-sized entity count
+ *
+ * Builds the same scene in SparseSet and Archetype mode - every entity has a
+ * Transform and a Velocity, a third also has Health - and times population,
+ * a two-component Each() integration pass, and a Transform+Health view that
+ * SparseSet mode leads with the smaller Health storage. Run with an optional count:
+ *   BenchmarkECS [entities]
+ */
+
+using namespace Enjin;
+using namespace Enjin::ECS;
+
+namespace {
+
+constexpr u32 ITERATION_PASSES = 20;
+
+struct Velocity {
+    Math::Vector3 linear = Math::Vector3(1.0f, 0.0f, 0.0f);
+};
+
+struct Health {
+    f32 value = 100.0f;
+};
+
+using Benchmark::Timer;
+
+struct Results {
+    f64 populate = 0.0;  // ms for the whole scene
+    f64 iterate = 0.0;   // ms per pass
+    f64 rare = 0.0;      // ms per pass
+    f32 checksum = 0.0f;
+};
+
+Results Run(StorageMode mode, usize count) {
+    Results results;
+    World world(mode);
+
+    Timer populate;
+    for (usize i = 0; i < count; ++i) {
+        Entity entity = world.CreateEntity();
+        TransformComponent transform;
+        transform.position = Math::Vector3(static_cast<f32>(i), 0.0f, 0.0f);
+        world.AddComponent(entity, transform);
+        world.AddComponent(entity, Velocity{});
+        if (i % 3 == 0) {
+            world.AddComponent(entity, Health{});
+        }
+    }
+    results.populate = populate.Milliseconds();
+
+    Timer iterate;
+    for (u32 pass = 0; pass < ITERATION_PASSES; ++pass) {
+        world.Each<TransformComponent, const Velocity>([](Entity, TransformComponent& transform, const Velocity& velocity) {
+            transform.position = transform.position + velocity.linear * 0.016f;
+        });
+    }
+    results.iterate = iterate.Milliseconds() / ITERATION_PASSES;
+
+    // SparseSet mode leads with the smallest storage (Health, a third of the scene)
+    Timer rare;
+    for (u32 pass = 0; pass < ITERATION_PASSES; ++pass) {
+        world.View<TransformComponent, Health>().Each([](TransformComponent& transform, Health& health) {
+            health.value -= transform.position.y * 0.001f;
+        });
+    }
+    results.rare = rare.Milliseconds() / ITERATION_PASSES;
+
+    world.Each<TransformComponent>([&results](Entity, TransformComponent& transform) {
+        results.checksum += transform.position.x;
+    });
+    return results;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    usize count = 500'000;
+    if (argc > 1) {
+        count = static_cast<usize>(std::max(1, std::atoi(argv[1])));
+    }
+
+    const Results sparse = Run(StorageMode::SparseSet, count);
+    const Results archetype = Run(StorageMode::Archetype, count);
+
+    std::printf("%zu entities (ms)\n", count);
+    std::printf("%14s %12s %12s %8s\n", "", "SparseSet", "Archetype", "speedup");
+    std::printf("%14s %12.2f %12.2f %7.2fx\n", "populate", sparse.populate, archetype.populate, sparse.populate / archetype.populate);
+    std::printf("%14s %12.3f %12.3f %7.2fx\n", "Each<T, V>", sparse.iterate, archetype.iterate, sparse.iterate / archetype.iterate);
+    std::printf("%14s %12.3f %12.3f %7.2fx\n", "View<T, H>", sparse.rare, archetype.rare, sparse.rare / archetype.rare);
+    std::printf("(checksum %.0f / %.0f)\n", sparse.checksum, archetype.checksum);
+    return 0;
+}
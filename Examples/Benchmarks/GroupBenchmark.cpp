@@ -0,0 +1,113 @@
+#include "Enjin/ECS/World.h"
+#include "Enjin/ECS/Components/Transform.h"
+#include "BenchmarkUtil.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+/**
+ * @file GroupBenchmark.cpp
+ * @brief Iterating Transform+Renderable through a view vs an owning group
+ *
+ * Every entity has a TransformComponent; a random half also gets a
+ * Renderable, added in shuffled order so the two storages disagree on
+ * order, as they do after a level has been edited for a while. The view
+ * walks the smaller storage and probes the other; the group walks both
+ * packed prefixes. Also times add/remove churn, which is where the group
+ * pays for its packing. Run with an optional count:
+ *   BenchmarkGroup [entities]
+ */
+
+using namespace Enjin;
+using namespace Enjin::ECS;
+
+namespace {
+
+constexpr u32 PASSES = 50;
+
+struct Renderable {
+    u32 mesh = 0;
+    u32 material = 0;
+    f32 sortKey = 0.0f;
+};
+
+using Benchmark::Timer;
+
+struct Results {
+    f64 iterate = 0.0; // ms per pass
+    f64 churn = 0.0;   // ms per remove+add of every tenth renderable
+    f64 checksum = 0.0;
+};
+
+Results Run(usize count, bool grouped) {
+    World world;
+    std::mt19937 rng(1234);
+
+    std::vector<Entity> entities(count);
+    world.CreateEntities(entities);
+    std::vector<TransformComponent> transforms(count);
+    for (usize i = 0; i < count; ++i) {
+        transforms[i].position = Math::Vector3(static_cast<f32>(i % 97), 0.0f, static_cast<f32>(i % 89));
+    }
+    world.AddComponents<TransformComponent>(entities, transforms);
+
+    if (grouped) {
+        world.Group<const TransformComponent, const Renderable>(); // Before the adds: maintained from here on
+    }
+
+    std::vector<Entity> renderables(entities.begin(), entities.end());
+    std::shuffle(renderables.begin(), renderables.end(), rng);
+    renderables.resize(count / 2);
+    for (usize i = 0; i < renderables.size(); ++i) {
+        world.AddComponent<Renderable>(renderables[i], Renderable{ static_cast<u32>(i % 16), static_cast<u32>(i % 4), 0.0f });
+    }
+
+    Results results;
+    for (u32 pass = 0; pass < PASSES; ++pass) {
+        f64 sum = 0.0;
+        Timer iterate;
+        auto visit = [&sum](const TransformComponent& transform, const Renderable& renderable) {
+            sum += transform.position.x + static_cast<f32>(renderable.mesh);
+        };
+        if (grouped) {
+            world.Group<const TransformComponent, const Renderable>().Each(visit);
+        } else {
+            world.View<const TransformComponent, const Renderable>().Each(visit);
+        }
+        results.iterate += iterate.Milliseconds();
+        results.checksum += sum;
+    }
+    results.iterate /= PASSES;
+
+    Timer churn;
+    for (usize i = 0; i < renderables.size(); i += 10) {
+        world.RemoveComponent<Renderable>(renderables[i]);
+    }
+    for (usize i = 0; i < renderables.size(); i += 10) {
+        world.AddComponent<Renderable>(renderables[i]);
+    }
+    results.churn = churn.Milliseconds();
+    return results;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    usize count = 200'000;
+    if (argc > 1) {
+        count = static_cast<usize>(std::max(1, std::atoi(argv[1])));
+    }
+
+    const Results view = Run(count, false);
+    const Results group = Run(count, true);
+    std::printf("%zu entities, %zu with Renderable (ms)\n", count, count / 2);
+    std::printf("%10s %10s %10s %8s\n", "", "view", "group", "speedup");
+    std::printf("%10s %10.3f %10.3f %7.2fx\n", "iterate", view.iterate, group.iterate, view.iterate / group.iterate);
+    std::printf("%10s %10.3f %10.3f %7.2fx\n", "churn", view.churn, group.churn, view.churn / group.churn);
+    if (view.checksum != group.checksum) {
+        std::printf("checksum mismatch: %f / %f\n", view.checksum, group.checksum);
+    }
+    return 0;
+}
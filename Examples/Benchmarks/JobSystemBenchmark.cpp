@@ -0,0 +1,92 @@
+#include "Enjin/Threading/JobSystem.h"
+#include "BenchmarkUtil.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * @file JobSystemBenchmark.cpp
+ * @brief Job throughput, nested waits and ParallelFor scaling
+ *
+ * Times a burst of tiny jobs (scheduling overhead), a binary tree of jobs
+ * that each wait on their children (waits that keep workers busy), and a
+ * ParallelFor over a large array against the same loop run serially. Run
+ * with an optional worker count:
+ *   BenchmarkJobSystem [workers]
+ */
+
+using namespace Enjin;
+
+namespace {
+
+constexpr u32 JOB_COUNT = 1'000'000;
+constexpr u32 TREE_DEPTH = 18;
+constexpr usize ARRAY_SIZE = 16 * 1024 * 1024;
+
+std::atomic<u32> s_Leaves{0};
+
+using Benchmark::Timer;
+
+void Empty(void*) {}
+
+void Tree(void* data) {
+    const uintptr_t depth = reinterpret_cast<uintptr_t>(data);
+    if (depth == 0) {
+        s_Leaves.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    JobCounter children;
+    JobSystem::Run(&Tree, reinterpret_cast<void*>(depth - 1), &children);
+    JobSystem::Run(&Tree, reinterpret_cast<void*>(depth - 1), &children);
+    JobSystem::Wait(children);
+}
+
+void Transform(f32* values, usize begin, usize end) {
+    for (usize i = begin; i < end; ++i) {
+        values[i] = std::sqrt(values[i] * 1.5f + 2.0f);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const u32 workers = argc > 1 ? static_cast<u32>(std::max(1, std::atoi(argv[1]))) : 0;
+    JobSystem::Initialize(workers);
+
+    Timer burst;
+    JobCounter counter;
+    for (u32 i = 0; i < JOB_COUNT; ++i) {
+        JobSystem::Run(&Empty, nullptr, &counter);
+    }
+    JobSystem::Wait(counter);
+    const f64 burstMs = burst.Milliseconds();
+
+    Timer tree;
+    JobCounter root;
+    JobSystem::Run(&Tree, reinterpret_cast<void*>(uintptr_t(TREE_DEPTH)), &root);
+    JobSystem::Wait(root);
+    const f64 treeMs = tree.Milliseconds();
+
+    std::vector<f32> values(ARRAY_SIZE, 1.0f);
+    Timer serial;
+    Transform(values.data(), 0, values.size());
+    const f64 serialMs = serial.Milliseconds();
+
+    Timer parallel;
+    JobSystem::ParallelFor(values.size(), [&values](usize begin, usize end) {
+        Transform(values.data(), begin, end);
+    });
+    const f64 parallelMs = parallel.Milliseconds();
+
+    std::printf("%u workers\n", JobSystem::GetWorkerCount());
+    std::printf("%24s %10.2f ms  (%.0f ns/job)\n", "1M empty jobs", burstMs, burstMs * 1e6 / JOB_COUNT);
+    std::printf("%24s %10.2f ms  (%u leaves)\n", "job tree, nested waits", treeMs, s_Leaves.load());
+    std::printf("%24s %10.2f ms\n", "serial loop", serialMs);
+    std::printf("%24s %10.2f ms  (%.2fx)\n", "ParallelFor", parallelMs, serialMs / parallelMs);
+
+    JobSystem::Shutdown();
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include "Enjin/Memory/ConcurrentPoolAllocator.h"
+#include "Enjin/Memory/Memory.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file PoolContentionBenchmark.cpp
+ * @brief Cross-thread fixed-size alloc/free under contention, 1 to 64 threads
+ *
+ * All threads share one table of slots. Each iteration allocates an object
+ * and swaps it into a random slot, freeing whatever was there - usually an
+ * object another thread allocated. Compares ConcurrentPoolAllocator with a
+ * mutex-guarded PoolAllocator and system malloc. Run with an optional cap:
+ *   BenchmarkPoolContention [maxThreads]
+ */
+
+using namespace Enjin;
+
+namespace {
+
+constexpr usize OPERATIONS_PER_THREAD = 1'000'000;
+constexpr usize SHARED_SLOTS = 4096;
+constexpr usize OBJECT_SIZE = 64;
+
+std::unique_ptr<ConcurrentPoolAllocator> s_ConcurrentPool;
+std::unique_ptr<PoolAllocator> s_LockedPool;
+std::mutex s_LockedPoolMutex;
+
+struct ConcurrentBackend {
+    static void* Alloc() { return s_ConcurrentPool->Allocate(OBJECT_SIZE); }
+    static void  Free(void* ptr) { s_ConcurrentPool->Deallocate(ptr); }
+};
+
+struct LockedPoolBackend {
+    static void* Alloc() {
+        std::lock_guard<std::mutex> lock(s_LockedPoolMutex);
+        return s_LockedPool->Allocate(OBJECT_SIZE);
+    }
+    static void Free(void* ptr) {
+        std::lock_guard<std::mutex> lock(s_LockedPoolMutex);
+        s_LockedPool->Deallocate(ptr);
+    }
+};
+
+struct MallocBackend {
+    static void* Alloc() { return std::malloc(OBJECT_SIZE); }
+    static void  Free(void* ptr) { std::free(ptr); }
+};
+
+// xorshift - cheap enough not to dominate the measurement
+inline u32 NextRandom(u32& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+template<typename Backend>
+void Worker(u32 seed, std::atomic<void*>* slots, std::atomic<bool>& start) {
+    u32 rng = seed * 2654435761u + 1;
+
+    while (!start.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+
+    for (usize i = 0; i < OPERATIONS_PER_THREAD; ++i) {
+        void* object = Backend::Alloc();
+        static_cast<u8*>(object)[0] = static_cast<u8>(i);
+        void* previous = slots[NextRandom(rng) % SHARED_SLOTS].exchange(object, std::memory_order_acq_rel);
+        if (previous) {
+            Backend::Free(previous);
+        }
+    }
+}
+
+template<typename Backend>
+f64 Run(u32 threadCount) {
+    std::vector<std::atomic<void*>> slots(SHARED_SLOTS);
+    for (auto& slot : slots) {
+        slot.store(nullptr, std::memory_order_relaxed);
+    }
+
+    std::atomic<bool> start{false};
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (u32 t = 0; t < threadCount; ++t) {
+        threads.emplace_back(Worker<Backend>, t + 1, slots.data(), std::ref(start));
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    for (auto& slot : slots) {
+        Backend::Free(slot.load(std::memory_order_relaxed));
+    }
+
+    f64 seconds = std::chrono::duration<f64>(end - begin).count();
+    return static_cast<f64>(OPERATIONS_PER_THREAD * threadCount) / seconds / 1.0e6;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    u32 maxThreads = 64;
+    if (argc > 1) {
+        maxThreads = std::max(1, std::atoi(argv[1]));
+    }
+
+    // Live objects never exceed the slot table plus one in flight per thread
+    s_ConcurrentPool = std::make_unique<ConcurrentPoolAllocator>(OBJECT_SIZE, 1u << 20);
+    s_LockedPool = std::make_unique<PoolAllocator>(PoolAllocatorDesc{ OBJECT_SIZE, 1024 });
+
+    std::printf("%8s %18s %18s %16s\n", "threads", "concurrent Mops/s", "locked pool Mops/s", "malloc Mops/s");
+    for (u32 threads = 1; threads <= maxThreads; threads *= 2) {
+        f64 concurrent = Run<ConcurrentBackend>(threads);
+        f64 locked = Run<LockedPoolBackend>(threads);
+        f64 system = Run<MallocBackend>(threads);
+        std::printf("%8u %18.1f %18.1f %16.1f\n", threads, concurrent, locked, system);
+        if (threads < maxThreads && threads * 2 > maxThreads) {
+            threads = maxThreads / 2; // Always finish on the full thread count
+        }
+    }
+    return 0;
+}
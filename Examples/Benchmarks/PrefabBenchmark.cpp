@@ -0,0 +1,111 @@
+#include "Enjin/ECS/World.h"
+#include "Enjin/ECS/Prefab.h"
+#include "Enjin/ECS/Components/Transform.h"
+#include "BenchmarkUtil.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * @file PrefabBenchmark.cpp
+ * @brief Spawning a projectile template by hand vs through World::Instantiate
+ *
+ * Each projectile has a placed TransformComponent plus three components
+ * copied from a template. "by hand" creates every entity and adds each
+ * component with AddComponent; "prefab" instantiates a Prefab of the three
+ * with one transform per instance. Two systems are registered so
+ * notifications are part of the cost. Run with an optional count:
+ *   BenchmarkPrefab [entities]
+ */
+
+using namespace Enjin;
+using namespace Enjin::ECS;
+
+namespace {
+
+constexpr u32 ROUNDS = 10;
+
+struct Velocity {
+    Math::Vector3 value;
+};
+
+struct Projectile {
+    f32 damage = 10.0f;
+    f32 life = 3.0f;
+    u32 owner = 0;
+};
+
+struct Collider {
+    f32 radius = 0.1f;
+    u32 layer = 2;
+    u32 mask = 0xFFu;
+};
+
+struct IdleSystem : ISystem {
+    void Update(f32) override {}
+};
+
+using Benchmark::Timer;
+
+// ms per spawn of count projectiles
+f64 Run(StorageMode mode, usize count, bool prefab) {
+    World world(mode);
+    for (u32 i = 0; i < 2; ++i) {
+        world.RegisterSystem<IdleSystem>();
+    }
+
+    const Velocity velocity{ Math::Vector3(0.0f, 0.0f, 40.0f) };
+    Prefab bullet;
+    bullet.Add<Velocity>(velocity).Add<Projectile>().Add<Collider>();
+
+    std::vector<TransformComponent> transforms(count);
+    for (usize i = 0; i < count; ++i) {
+        transforms[i].position = Math::Vector3(static_cast<f32>(i % 64), 1.0f, static_cast<f32>(i / 64));
+    }
+    std::vector<Entity> entities(count);
+
+    f64 total = 0.0;
+    for (u32 round = 0; round < ROUNDS; ++round) {
+        Timer spawn;
+        if (prefab) {
+            world.Instantiate(bullet, entities, transforms);
+        } else {
+            for (usize i = 0; i < count; ++i) {
+                entities[i] = world.CreateEntity();
+                world.AddComponent<TransformComponent>(entities[i], transforms[i]);
+                world.AddComponent<Velocity>(entities[i], velocity);
+                world.AddComponent<Projectile>(entities[i]);
+                world.AddComponent<Collider>(entities[i]);
+            }
+        }
+        total += spawn.Milliseconds();
+
+        if (world.GetEntityCount() != count) {
+            std::printf("entity count mismatch: %zu\n", world.GetEntityCount());
+        }
+        world.DestroyEntities(entities);
+    }
+    return total / ROUNDS;
+}
+
+void Print(const char* label, StorageMode mode, usize count) {
+    const f64 manual = Run(mode, count, false);
+    const f64 prefab = Run(mode, count, true);
+    std::printf("%10s %10.2f %10.2f %7.2fx\n", label, manual, prefab, manual / prefab);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    usize count = 100'000;
+    if (argc > 1) {
+        count = static_cast<usize>(std::max(1, std::atoi(argv[1])));
+    }
+
+    std::printf("%zu projectiles per spawn (ms)\n", count);
+    std::printf("%10s %10s %10s %8s\n", "", "by hand", "prefab", "speedup");
+    Print("SparseSet", StorageMode::SparseSet, count);
+    Print("Archetype", StorageMode::Archetype, count);
+    return 0;
+}
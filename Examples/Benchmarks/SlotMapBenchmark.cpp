@@ -0,0 +1,142 @@
+#include "Enjin/Containers/SlotMap.h"
+#include "BenchmarkUtil.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file SlotMapBenchmark.cpp
+ * @brief SlotMap vs the unordered_map<u32, T> id tables it replaces
+ *
+ * Measures insert, random lookup by handle/id, iteration over all values and
+ * erase+insert churn for a 64-byte payload. Run with an optional element count:
+ *   BenchmarkSlotMap [count]
+ */
+
+using namespace Enjin;
+
+namespace {
+
+constexpr usize LOOKUPS = 10'000'000;
+
+struct Payload {
+    f32 data[16];
+};
+
+inline u32 NextRandom(u32& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+using Benchmark::Timer;
+
+struct Results {
+    f64 insert = 0.0;
+    f64 lookup = 0.0;
+    f64 iterate = 0.0;
+    f64 churn = 0.0;
+    f32 checksum = 0.0f; // Keeps the optimizer honest
+};
+
+Results RunSlotMap(usize count) {
+    Results results;
+    SlotMap<Payload> map;
+    std::vector<SlotHandle32> handles;
+    handles.reserve(count);
+
+    Timer insert;
+    for (usize i = 0; i < count; ++i) {
+        Payload payload{};
+        payload.data[0] = static_cast<f32>(i);
+        handles.push_back(map.Insert(payload));
+    }
+    results.insert = insert.Nanoseconds(count);
+
+    u32 rng = 12345;
+    Timer lookup;
+    for (usize i = 0; i < LOOKUPS; ++i) {
+        results.checksum += map.Get(handles[NextRandom(rng) % count])->data[0];
+    }
+    results.lookup = lookup.Nanoseconds(LOOKUPS);
+
+    Timer iterate;
+    for (const Payload& payload : map) {
+        results.checksum += payload.data[0];
+    }
+    results.iterate = iterate.Nanoseconds(count);
+
+    Timer churn;
+    for (usize i = 0; i < count; ++i) {
+        SlotHandle32& handle = handles[NextRandom(rng) % count];
+        map.Erase(handle);
+        handle = map.Insert(Payload{});
+    }
+    results.churn = churn.Nanoseconds(count);
+    return results;
+}
+
+Results RunUnorderedMap(usize count) {
+    Results results;
+    std::unordered_map<u32, Payload> map;
+    std::vector<u32> ids;
+    ids.reserve(count);
+    u32 nextId = 1;
+
+    Timer insert;
+    for (usize i = 0; i < count; ++i) {
+        Payload payload{};
+        payload.data[0] = static_cast<f32>(i);
+        map.emplace(nextId, payload);
+        ids.push_back(nextId++);
+    }
+    results.insert = insert.Nanoseconds(count);
+
+    u32 rng = 12345;
+    Timer lookup;
+    for (usize i = 0; i < LOOKUPS; ++i) {
+        auto it = map.find(ids[NextRandom(rng) % count]);
+        results.checksum += it->second.data[0];
+    }
+    results.lookup = lookup.Nanoseconds(LOOKUPS);
+
+    Timer iterate;
+    for (const auto& [id, payload] : map) {
+        results.checksum += payload.data[0];
+    }
+    results.iterate = iterate.Nanoseconds(count);
+
+    Timer churn;
+    for (usize i = 0; i < count; ++i) {
+        u32& id = ids[NextRandom(rng) % count];
+        map.erase(id);
+        id = nextId++;
+        map.emplace(id, Payload{});
+    }
+    results.churn = churn.Nanoseconds(count);
+    return results;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    usize count = 100'000;
+    if (argc > 1) {
+        count = static_cast<usize>(std::max(1, std::atoi(argv[1])));
+    }
+
+    const Results slot = RunSlotMap(count);
+    const Results hash = RunUnorderedMap(count);
+
+    std::printf("%zu elements, %zu random lookups (ns/op)\n", count, LOOKUPS);
+    std::printf("%10s %14s %14s %8s\n", "", "SlotMap", "unordered_map", "speedup");
+    std::printf("%10s %14.2f %14.2f %7.2fx\n", "insert", slot.insert, hash.insert, hash.insert / slot.insert);
+    std::printf("%10s %14.2f %14.2f %7.2fx\n", "lookup", slot.lookup, hash.lookup, hash.lookup / slot.lookup);
+    std::printf("%10s %14.2f %14.2f %7.2fx\n", "iterate", slot.iterate, hash.iterate, hash.iterate / slot.iterate);
+    std::printf("%10s %14.2f %14.2f %7.2fx\n", "churn", slot.churn, hash.churn, hash.churn / slot.churn);
+    std::printf("(checksum %.0f / %.0f)\n", slot.checksum, hash.checksum);
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "Enjin/ECS/World.h"
+#include "Enjin/ECS/Components/Transform.h"
+#include "Enjin/ECS/Components/Hierarchy.h"
+#include "BenchmarkUtil.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+/**
+ * @file SnapshotBenchmark.cpp
+ * @brief Level load from a binary snapshot vs rebuilding the world entity by entity
+ *
+ * The scene has a Transform and a Velocity on every entity and a parent on
+ * all but the roots. "rebuild" creates it with CreateEntity/AddComponent as
+ * a level loader would after parsing; "load" maps a snapshot of it and bulk
+ * copies the columns. Run with an optional count and snapshot path:
+ *   BenchmarkSnapshot [entities] [path]
+ */
+
+using namespace Enjin;
+using namespace Enjin::ECS;
+
+namespace {
+
+struct Velocity {
+    Math::Vector3 linear = Math::Vector3(0.0f, 1.0f, 0.0f);
+};
+
+using Benchmark::Timer;
+
+void Build(World& world, usize count) {
+    for (usize i = 0; i < count; ++i) {
+        Entity entity = world.CreateEntity();
+        TransformComponent transform;
+        transform.position = Math::Vector3(static_cast<f32>(i), 0.0f, 0.0f);
+        world.AddComponent(entity, transform);
+        world.AddComponent(entity, Velocity{});
+        if (i >= 64) {
+            world.AddComponent<HierarchyComponent>(entity).parent = MakeEntity(static_cast<u32>((i - 64) / 4), 1);
+        }
+    }
+}
+
+void Run(const char* label, StorageMode mode, usize count, const std::string& path) {
+    Timer rebuild;
+    World source(mode);
+    Build(source, count);
+    const f64 rebuildMs = rebuild.Milliseconds();
+
+    Timer save;
+    const bool saved = source.SaveSnapshot<TransformComponent, Velocity, HierarchyComponent>(path);
+    const f64 saveMs = save.Milliseconds();
+
+    Timer load;
+    World loaded(mode);
+    const bool ok = loaded.LoadSnapshot<TransformComponent, Velocity, HierarchyComponent>(path);
+    const f64 loadMs = load.Milliseconds();
+
+    if (!saved || !ok || loaded.GetEntityCount() != count) {
+        std::printf("%s: snapshot round trip failed\n", label);
+        return;
+    }
+    std::printf("%10s %10.2f %10.2f %10.2f %7.2fx\n", label, rebuildMs, saveMs, loadMs, rebuildMs / loadMs);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    usize count = 500'000;
+    if (argc > 1) {
+        count = static_cast<usize>(std::max(1, std::atoi(argv[1])));
+    }
+    const std::string path = argc > 2 ? argv[2] : "BenchmarkSnapshot.snap";
+
+    std::printf("%zu entities (ms)\n", count);
+    std::printf("%10s %10s %10s %10s %8s\n", "", "rebuild", "save", "load", "speedup");
+    Run("SparseSet", StorageMode::SparseSet, count, path);
+    Run("Archetype", StorageMode::Archetype, count, path);
+    std::remove(path.c_str());
+    return 0;
+}
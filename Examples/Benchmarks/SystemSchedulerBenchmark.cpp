@@ -0,0 +1,144 @@
+#include "Enjin/ECS/World.h"
+#include "Enjin/ECS/Components/Transform.h"
+#include "Enjin/Threading/JobSystem.h"
+#include "BenchmarkUtil.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * @file SystemSchedulerBenchmark.cpp
+ * @brief Frame time of a small simulation, serial vs on the JobSystem
+ *
+ * Three systems with disjoint write sets (movement, health regen, AI
+ * timers) update every entity each frame. Serial runs them one after
+ * another on one thread; Scheduled initializes the JobSystem so the
+ * SystemManager runs them concurrently and each splits its view with
+ * ParallelEach. Run with an optional count:
+ *   BenchmarkSystemScheduler [entities]
+ */
+
+using namespace Enjin;
+using namespace Enjin::ECS;
+
+namespace {
+
+constexpr u32 FRAMES = 30;
+
+struct Velocity {
+    Math::Vector3 linear = Math::Vector3(1.0f, 0.5f, 0.0f);
+};
+
+struct Health {
+    f32 value = 50.0f;
+    f32 regen = 0.5f;
+};
+
+struct Brain {
+    f32 timer = 0.0f;
+    u32 state = 0;
+};
+
+using Benchmark::Timer;
+
+class MovementSystem : public ISystem {
+public:
+    explicit MovementSystem(World* world) : m_World(world) {}
+
+    void DeclareAccess(SystemAccess& access) override {
+        access.Read<Velocity>().Write<TransformComponent>();
+    }
+
+    void Update(f32 deltaTime) override {
+        m_World->View<TransformComponent, const Velocity>().ParallelEach(
+            [deltaTime](TransformComponent& transform, const Velocity& velocity) {
+                transform.position = transform.position + velocity.linear * deltaTime;
+                transform.rotation = transform.rotation * Math::Quaternion::FromEuler(Math::Vector3(0.0f, deltaTime, 0.0f));
+            });
+    }
+
+private:
+    World* m_World;
+};
+
+class HealthSystem : public ISystem {
+public:
+    explicit HealthSystem(World* world) : m_World(world) {}
+
+    void DeclareAccess(SystemAccess& access) override {
+        access.Write<Health>();
+    }
+
+    void Update(f32 deltaTime) override {
+        m_World->View<Health>().ParallelEach([deltaTime](Health& health) {
+            health.value = std::min(100.0f, health.value + health.regen * deltaTime * std::sqrt(health.value));
+        });
+    }
+
+private:
+    World* m_World;
+};
+
+class BrainSystem : public ISystem {
+public:
+    explicit BrainSystem(World* world) : m_World(world) {}
+
+    void DeclareAccess(SystemAccess& access) override {
+        access.Read<TransformComponent>().Write<Brain>();
+    }
+
+    void Update(f32 deltaTime) override {
+        m_World->View<Brain, const TransformComponent>().ParallelEach([deltaTime](Brain& brain, const TransformComponent& transform) {
+            brain.timer += deltaTime;
+            if (brain.timer > 1.0f || transform.position.Length() > 1000.0f) {
+                brain.timer = 0.0f;
+                brain.state = (brain.state + 1) % 4;
+            }
+        });
+    }
+
+private:
+    World* m_World;
+};
+
+f64 Run(usize count) {
+    World world;
+    for (usize i = 0; i < count; ++i) {
+        Entity entity = world.CreateEntity();
+        world.AddComponent(entity, TransformComponent{});
+        world.AddComponent(entity, Velocity{});
+        world.AddComponent(entity, Health{});
+        world.AddComponent(entity, Brain{});
+    }
+    world.RegisterSystem<MovementSystem>(&world);
+    world.RegisterSystem<HealthSystem>(&world);
+    world.RegisterSystem<BrainSystem>(&world);
+
+    world.Update(0.016f); // Warm up (builds the schedule)
+    Timer timer;
+    for (u32 frame = 0; frame < FRAMES; ++frame) {
+        world.Update(0.016f);
+    }
+    return timer.Milliseconds() / FRAMES;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    usize count = 200'000;
+    if (argc > 1) {
+        count = static_cast<usize>(std::max(1, std::atoi(argv[1])));
+    }
+
+    const f64 serial = Run(count);
+    JobSystem::Initialize();
+    const f64 scheduled = Run(count);
+    const u32 workers = JobSystem::GetWorkerCount();
+    JobSystem::Shutdown();
+
+    std::printf("%zu entities, 3 systems (ms per frame)\n", count);
+    std::printf("%10s %10.3f\n", "serial", serial);
+    std::printf("%10s %10.3f  (%u workers, %.2fx)\n", "scheduled", scheduled, workers, serial / scheduled);
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include "Enjin/ECS/World.h"
+#include "Enjin/ECS/Components/Transform.h"
+#include "Enjin/ECS/Components/Hierarchy.h"
+#include "Enjin/ECS/Systems/TransformSystem.h"
+#include "Enjin/Threading/JobSystem.h"
+#include "BenchmarkUtil.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * @file TransformHierarchyBenchmark.cpp
+ * @brief World matrix update cost for a large prop hierarchy
+ *
+ * A forest of 256 trees with three children per node. "naive" recomputes
+ * every world matrix each frame by walking up the parent chain with generic
+ * 4x4 products; the TransformSystem rows update the depth-sorted arrays
+ * when nothing, 1% or every transform changed. Run with an optional count:
+ *   BenchmarkTransformHierarchy [entities]
+ */
+
+using namespace Enjin;
+using namespace Enjin::ECS;
+
+namespace {
+
+constexpr u32 FRAMES = 30;
+constexpr usize ROOTS = 256;
+constexpr usize BRANCHING = 3;
+
+using Benchmark::Timer;
+
+void BuildScene(World& world, std::vector<Entity>& entities, usize count) {
+    for (usize i = 0; i < count; ++i) {
+        Entity entity = world.CreateEntity();
+        TransformComponent& transform = world.AddComponent<TransformComponent>(entity);
+        transform.position = Math::Vector3(1.0f, 0.0f, 0.5f);
+        transform.rotation = Math::Quaternion::FromEuler(Math::Vector3(0.0f, 0.1f * static_cast<f32>(i % 7), 0.0f));
+        if (i >= ROOTS) {
+            world.AddComponent<HierarchyComponent>(entity).parent = entities[(i - ROOTS) / BRANCHING];
+        }
+        entities.push_back(entity);
+    }
+}
+
+// Parent chain walk with full matrix products, as done without a hierarchy system
+f64 RunNaive(usize count) {
+    World world;
+    std::vector<Entity> entities;
+    BuildScene(world, entities, count);
+    const World& scene = world;
+    std::vector<Math::Matrix4> worldMatrices(count);
+
+    Timer timer;
+    for (u32 frame = 0; frame < FRAMES; ++frame) {
+        for (usize i = 0; i < count; ++i) {
+            Math::Matrix4 matrix = Math::Matrix4::Identity();
+            for (Entity entity = entities[i]; scene.IsValid(entity);) {
+                const TransformComponent* transform = scene.GetComponent<TransformComponent>(entity);
+                matrix = Math::Matrix4::Translation(transform->position) * transform->rotation.ToMatrix() *
+                         Math::Matrix4::Scale(transform->scale) * matrix;
+                const HierarchyComponent* hierarchy = scene.GetComponent<HierarchyComponent>(entity);
+                entity = hierarchy ? hierarchy->parent : INVALID_ENTITY;
+            }
+            worldMatrices[i] = matrix;
+        }
+    }
+    return timer.Milliseconds() / FRAMES;
+}
+
+// changedPerFrame transforms are written before each update
+f64 RunSystem(usize count, usize changedPerFrame) {
+    World world;
+    std::vector<Entity> entities;
+    BuildScene(world, entities, count);
+    TransformSystem* transforms = world.RegisterSystem<TransformSystem>(&world);
+    world.Update(0.016f); // Builds the sorted layout
+
+    f64 total = 0.0;
+    usize next = 0;
+    for (u32 frame = 0; frame < FRAMES; ++frame) {
+        for (usize i = 0; i < changedPerFrame; ++i) {
+            next = (next + 7919) % count;
+            world.GetComponent<TransformComponent>(entities[next])->position.y += 0.01f;
+        }
+        Timer timer;
+        world.Update(0.016f);
+        total += timer.Milliseconds();
+    }
+    if (!transforms->GetWorldMatrix(entities.back())) {
+        std::printf("missing world matrix\n");
+    }
+    return total / FRAMES;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    usize count = 200'000;
+    if (argc > 1) {
+        count = static_cast<usize>(std::max(static_cast<int>(ROOTS), std::atoi(argv[1])));
+    }
+
+    JobSystem::Initialize();
+    const f64 naive = RunNaive(count);
+    const f64 idle = RunSystem(count, 0);
+    const f64 some = RunSystem(count, count / 100);
+    const f64 all = RunSystem(count, count);
+    const u32 workers = JobSystem::GetWorkerCount();
+    JobSystem::Shutdown();
+
+    std::printf("%zu entities, %u workers (ms per frame)\n", count, workers);
+    std::printf("%16s %10.3f\n", "naive", naive);
+    std::printf("%16s %10.3f\n", "system, idle", idle);
+    std::printf("%16s %10.3f\n", "system, 1% moved", some);
+    std::printf("%16s %10.3f\n", "system, all", all);
+    return 0;
+}